@@ -0,0 +1,108 @@
+#include "BenchGenerators.h"
+#include <algorithm>
+
+namespace BenchGenerators{
+
+std::string Word(CRandom &random, std::size_t minlength, std::size_t maxlength){
+    std::size_t Length = minlength + random.Below(maxlength - minlength + 1);
+    std::string Result;
+    for(std::size_t Index = 0; Index < Length; Index++){
+        Result += static_cast<char>('a' + random.Below(26));
+    }
+    return Result;
+}
+
+std::string DSV(std::size_t rows, std::size_t columns, char delimiter){
+    CRandom Random;
+    std::string Result;
+    for(std::size_t Row = 0; Row < rows; Row++){
+        for(std::size_t Column = 0; Column < columns; Column++){
+            if(Column){
+                Result += delimiter;
+            }
+            if(Column % 3 == 1){
+                Result += std::to_string(Random.Next() % 100000);
+            }
+            else{
+                Result += Word(Random, 3, 12);
+            }
+        }
+        Result += '\n';
+    }
+    return Result;
+}
+
+std::string QuotedDSV(std::size_t rows, std::size_t columns, char delimiter){
+    CRandom Random;
+    std::string Result;
+    for(std::size_t Row = 0; Row < rows; Row++){
+        for(std::size_t Column = 0; Column < columns; Column++){
+            if(Column){
+                Result += delimiter;
+            }
+            Result += '"';
+            Result += Word(Random, 2, 8);
+            switch(Random.Below(4)){
+                case 0:     Result += delimiter;
+                            break;
+                case 1:     Result += "\"\"";
+                            break;
+                case 2:     Result += '\n';
+                            break;
+                default:    break;
+            }
+            Result += Word(Random, 2, 8);
+            Result += '"';
+        }
+        Result += '\n';
+    }
+    return Result;
+}
+
+std::string FlatXML(std::size_t elements){
+    CRandom Random;
+    std::string Result = "<root>";
+    for(std::size_t Element = 0; Element < elements; Element++){
+        Result += "<item id=\"" + std::to_string(Element) + "\">" + Word(Random, 4, 16) + "</item>";
+    }
+    Result += "</root>";
+    return Result;
+}
+
+std::string DeepXML(std::size_t elements, std::size_t depth){
+    CRandom Random;
+    std::string Result = "<root>";
+    std::size_t Written = 0;
+    while(Written < elements){
+        std::size_t Levels = std::min(depth, elements - Written);
+        for(std::size_t Level = 0; Level < Levels; Level++){
+            Result += "<level" + std::to_string(Level) + ">" + Word(Random, 2, 6);
+        }
+        for(std::size_t Level = Levels; Level > 0; Level--){
+            Result += "</level" + std::to_string(Level - 1) + ">";
+        }
+        Written += Levels;
+    }
+    Result += "</root>";
+    return Result;
+}
+
+std::string AttributeXML(std::size_t elements, std::size_t attributes){
+    CRandom Random;
+    std::string Result = "<root>";
+    for(std::size_t Element = 0; Element < elements; Element++){
+        Result += "<record";
+        for(std::size_t Attribute = 0; Attribute < attributes; Attribute++){
+            Result += " attr" + std::to_string(Attribute) + "=\"" + Word(Random, 1, 10);
+            if(!Random.Below(8)){
+                Result += "&amp;";
+            }
+            Result += "\"";
+        }
+        Result += "/>";
+    }
+    Result += "</root>";
+    return Result;
+}
+
+}
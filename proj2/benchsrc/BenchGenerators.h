@@ -0,0 +1,44 @@
+#ifndef BENCHGENERATORS_H
+#define BENCHGENERATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Deterministic synthetic inputs for the benchmarks. The same arguments
+// always produce the same text, so results stay comparable between runs.
+namespace BenchGenerators{
+
+// Small linear congruential generator, fixed so output does not depend on
+// the standard library implementation
+class CRandom{
+    private:
+        uint64_t DState;
+    public:
+        CRandom(uint64_t seed = 0x9E3779B97F4A7C15ULL) : DState(seed){};
+
+        uint32_t Next() noexcept{
+            DState = DState * 6364136223846793005ULL + 1442695040888963407ULL;
+            return DState >> 33;
+        };
+        uint32_t Below(uint32_t bound) noexcept{
+            return Next() % bound;
+        };
+};
+
+std::string Word(CRandom &random, std::size_t minlength, std::size_t maxlength);
+
+// Plain fields of words and numbers
+std::string DSV(std::size_t rows, std::size_t columns, char delimiter = ',');
+// Fields with delimiters, newlines and escaped quotes inside quotes
+std::string QuotedDSV(std::size_t rows, std::size_t columns, char delimiter = ',');
+// Many sibling elements with short text under a single root
+std::string FlatXML(std::size_t elements);
+// Nested elements depth levels deep, repeated until elements are written
+std::string DeepXML(std::size_t elements, std::size_t depth);
+// Empty elements carrying many attributes each
+std::string AttributeXML(std::size_t elements, std::size_t attributes);
+
+}
+
+#endif
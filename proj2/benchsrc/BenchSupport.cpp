@@ -0,0 +1,43 @@
+#include "BenchSupport.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace{
+
+std::atomic<uint64_t> Allocations(0);
+
+}
+
+uint64_t AllocationCount() noexcept{
+    return Allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size){
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    void *Pointer = std::malloc(size ? size : 1);
+    if(!Pointer){
+        throw std::bad_alloc();
+    }
+    return Pointer;
+}
+
+void *operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
@@ -0,0 +1,20 @@
+#ifndef BENCHSUPPORT_H
+#define BENCHSUPPORT_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Number of global operator new calls made by the process so far. The
+// counter is kept by the replacement operators in BenchSupport.cpp.
+uint64_t AllocationCount() noexcept;
+
+// Reports MB/s, rows/s and allocations per row for a benchmark that handled
+// bytes and rows on every iteration and made allocations in total
+inline void ReportThroughput(benchmark::State &state, std::size_t bytes, std::size_t rows, uint64_t allocations){
+    double Iterations = state.iterations();
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["rows/s"] = benchmark::Counter(Iterations * rows, benchmark::Counter::kIsRate);
+    state.counters["allocs/row"] = rows ? allocations / (Iterations * rows) : 0.0;
+}
+
+#endif
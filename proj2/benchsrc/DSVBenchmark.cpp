@@ -0,0 +1,76 @@
+#include "BenchGenerators.h"
+#include "BenchSupport.h"
+#include "DSVReader.h"
+#include "DSVWriter.h"
+#include "StringDataSink.h"
+#include "StringDataSource.h"
+
+// Range arguments are the number of rows and columns
+static void ReadRows(benchmark::State &state, const std::string &input){
+    std::size_t Rows = 0;
+    uint64_t Allocations = 0;
+    std::vector<std::string> Row;
+    for(auto _ : state){
+        CDSVReader Reader(std::make_shared<CStringDataSource>(input), ',');
+        uint64_t Start = AllocationCount();
+        Rows = 0;
+        while(Reader.ReadRow(Row)){
+            Rows++;
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Row.data());
+    }
+    ReportThroughput(state, input.size(), Rows, Allocations);
+}
+
+static void BM_DSVReadRow(benchmark::State &state){
+    ReadRows(state, BenchGenerators::DSV(state.range(0), state.range(1)));
+}
+BENCHMARK(BM_DSVReadRow)->Args({100000, 4})->Args({10000, 64});
+
+static void BM_DSVReadRowQuoted(benchmark::State &state){
+    ReadRows(state, BenchGenerators::QuotedDSV(state.range(0), state.range(1)));
+}
+BENCHMARK(BM_DSVReadRowQuoted)->Args({20000, 16});
+
+static void BM_DSVReadRowView(benchmark::State &state){
+    std::string Input = BenchGenerators::DSV(state.range(0), state.range(1));
+    std::size_t Rows = 0;
+    uint64_t Allocations = 0;
+    std::vector<std::string_view> Row;
+    for(auto _ : state){
+        CDSVReader Reader(std::make_shared<CStringDataSource>(Input), ',');
+        uint64_t Start = AllocationCount();
+        Rows = 0;
+        while(Reader.ReadRowView(Row)){
+            Rows++;
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Row.data());
+    }
+    ReportThroughput(state, Input.size(), Rows, Allocations);
+}
+BENCHMARK(BM_DSVReadRowView)->Args({100000, 4})->Args({10000, 64});
+
+static void BM_DSVWriteRow(benchmark::State &state){
+    std::vector< std::vector<std::string> > Rows;
+    CDSVReader Reader(std::make_shared<CStringDataSource>(BenchGenerators::QuotedDSV(state.range(0), state.range(1))), ',');
+    std::vector<std::string> Row;
+    while(Reader.ReadRow(Row)){
+        Rows.push_back(Row);
+    }
+    std::size_t Bytes = 0;
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        auto Sink = std::make_shared<CStringDataSink>();
+        CDSVWriter Writer(Sink, ',');
+        uint64_t Start = AllocationCount();
+        for(auto &Row : Rows){
+            Writer.WriteRow(Row);
+        }
+        Allocations += AllocationCount() - Start;
+        Bytes = Sink->String().size();
+    }
+    ReportThroughput(state, Bytes, Rows.size(), Allocations);
+}
+BENCHMARK(BM_DSVWriteRow)->Args({20000, 16});
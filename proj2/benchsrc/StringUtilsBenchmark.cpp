@@ -0,0 +1,109 @@
+#include "BenchGenerators.h"
+#include "BenchSupport.h"
+#include "StringReplacer.h"
+#include "StringUtils.h"
+
+// Rows are the generated fields each function is applied to. Words of up to
+// 6 characters keep the fields shorter than one AVX2 register, so only the
+// kernels' tail handling runs.
+static std::vector<std::string> Fields(std::size_t count, std::size_t maxword = 40){
+    BenchGenerators::CRandom Random;
+    std::vector<std::string> Result;
+    for(std::size_t Index = 0; Index < count; Index++){
+        Result.push_back("  " + BenchGenerators::Word(Random, 4, maxword) + " <b>&amp; " + BenchGenerators::Word(Random, 4, maxword) + "\t");
+    }
+    return Result;
+}
+
+static std::size_t TotalSize(const std::vector<std::string> &fields){
+    std::size_t Size = 0;
+    for(auto &Field : fields){
+        Size += Field.size();
+    }
+    return Size;
+}
+
+static void BM_StringUtilsStrip(benchmark::State &state){
+    auto Input = Fields(state.range(0), state.range(1));
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        uint64_t Start = AllocationCount();
+        for(auto &Field : Input){
+            benchmark::DoNotOptimize(StringUtils::StripView(Field));
+        }
+        Allocations += AllocationCount() - Start;
+    }
+    ReportThroughput(state, TotalSize(Input), Input.size(), Allocations);
+}
+BENCHMARK(BM_StringUtilsStrip)->Args({10000, 40})->Args({10000, 6});
+
+static void BM_StringUtilsUpper(benchmark::State &state){
+    auto Input = Fields(state.range(0), state.range(1));
+    uint64_t Allocations = 0;
+    std::string Buffer;
+    for(auto _ : state){
+        uint64_t Start = AllocationCount();
+        for(auto &Field : Input){
+            Buffer.clear();
+            StringUtils::AppendUpper(Buffer, Field);
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Buffer.data());
+    }
+    ReportThroughput(state, TotalSize(Input), Input.size(), Allocations);
+}
+BENCHMARK(BM_StringUtilsUpper)->Args({10000, 40})->Args({10000, 6});
+
+static void BM_StringUtilsSplit(benchmark::State &state){
+    auto Input = Fields(state.range(0));
+    uint64_t Allocations = 0;
+    std::vector<std::string_view> Parts;
+    for(auto _ : state){
+        uint64_t Start = AllocationCount();
+        for(auto &Field : Input){
+            StringUtils::SplitView(Field, Parts);
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Parts.data());
+    }
+    ReportThroughput(state, TotalSize(Input), Input.size(), Allocations);
+}
+BENCHMARK(BM_StringUtilsSplit)->Arg(10000);
+
+static void BM_StringUtilsReplaceTable(benchmark::State &state){
+    auto Input = Fields(state.range(0));
+    std::vector< std::pair< std::string, std::string > > Table = {{"&amp;", "&"}, {"<b>", ""}, {"\t", " "}};
+    for(char Letter = 'a'; Letter <= 'z'; Letter += 2){
+        Table.emplace_back(std::string(2, Letter), std::string(1, Letter));
+    }
+    CStringReplacer Replacer(Table);
+    uint64_t Allocations = 0;
+    std::string Buffer;
+    for(auto _ : state){
+        uint64_t Start = AllocationCount();
+        for(auto &Field : Input){
+            Buffer.clear();
+            Replacer.Append(Buffer, Field);
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Buffer.data());
+    }
+    ReportThroughput(state, TotalSize(Input), Input.size(), Allocations);
+}
+BENCHMARK(BM_StringUtilsReplaceTable)->Arg(10000);
+
+static void BM_StringUtilsFindMatches(benchmark::State &state){
+    BenchGenerators::CRandom Random;
+    std::vector<std::string> Dictionary;
+    for(int64_t Index = 0; Index < state.range(0); Index++){
+        Dictionary.push_back(BenchGenerators::Word(Random, 5, 14));
+    }
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        uint64_t Start = AllocationCount();
+        benchmark::DoNotOptimize(StringUtils::FindMatches("benchmark", Dictionary, 2));
+        Allocations += AllocationCount() - Start;
+    }
+    ReportThroughput(state, TotalSize(Dictionary), Dictionary.size(), Allocations);
+}
+BENCHMARK(BM_StringUtilsFindMatches)->Arg(100000);
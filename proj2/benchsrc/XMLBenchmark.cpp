@@ -0,0 +1,182 @@
+#include "BenchGenerators.h"
+#include "BenchSupport.h"
+#include "StringDataSink.h"
+#include "StringDataSource.h"
+#include "XMLDocument.h"
+#include "XMLReader.h"
+#include "XMLWriter.h"
+
+// Rows are counted as entities read or written
+static void ReadEntities(benchmark::State &state, const std::string &input){
+    std::size_t Entities = 0;
+    uint64_t Allocations = 0;
+    SXMLEntity Entity;
+    for(auto _ : state){
+        CXMLReader Reader(std::make_shared<CStringDataSource>(input));
+        uint64_t Start = AllocationCount();
+        Entities = 0;
+        while(Reader.ReadEntity(Entity)){
+            Entities++;
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Entity.DNameData.data());
+    }
+    ReportThroughput(state, input.size(), Entities, Allocations);
+}
+
+static void BM_XMLReadFlat(benchmark::State &state){
+    ReadEntities(state, BenchGenerators::FlatXML(state.range(0)));
+}
+BENCHMARK(BM_XMLReadFlat)->Arg(50000);
+
+static void BM_XMLReadDeep(benchmark::State &state){
+    ReadEntities(state, BenchGenerators::DeepXML(state.range(0), state.range(1)));
+}
+BENCHMARK(BM_XMLReadDeep)->Args({50000, 64});
+
+static void BM_XMLReadAttributes(benchmark::State &state){
+    ReadEntities(state, BenchGenerators::AttributeXML(state.range(0), state.range(1)));
+}
+BENCHMARK(BM_XMLReadAttributes)->Args({10000, 24});
+
+static void BM_XMLReadEntityView(benchmark::State &state){
+    std::string Input = BenchGenerators::AttributeXML(state.range(0), state.range(1));
+    std::size_t Entities = 0;
+    uint64_t Allocations = 0;
+    SXMLEntityView Entity;
+    for(auto _ : state){
+        CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+        uint64_t Start = AllocationCount();
+        Entities = 0;
+        while(Reader.ReadEntityView(Entity)){
+            Entities++;
+        }
+        Allocations += AllocationCount() - Start;
+    }
+    ReportThroughput(state, Input.size(), Entities, Allocations);
+}
+BENCHMARK(BM_XMLReadEntityView)->Args({10000, 24});
+
+// Rows are the entities in the document, most of which the filter skips
+static void BM_XMLReadFiltered(benchmark::State &state){
+    std::string Input = BenchGenerators::DeepXML(state.range(0), state.range(1));
+    CXMLPathFilter Filter;
+    Filter.AddPath("/root/level0/level1/level2[@missing]|//level60");
+    std::size_t Entities = 0;
+    uint64_t Allocations = 0;
+    SXMLEntity Entity;
+    for(auto _ : state){
+        CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+        Reader.SetFilter(Filter);
+        uint64_t Start = AllocationCount();
+        while(Reader.ReadEntity(Entity)){
+        }
+        Allocations += AllocationCount() - Start;
+    }
+    CXMLReader Counter(std::make_shared<CStringDataSource>(Input));
+    while(Counter.ReadEntity(Entity)){
+        Entities++;
+    }
+    ReportThroughput(state, Input.size(), Entities, Allocations);
+}
+BENCHMARK(BM_XMLReadFiltered)->Args({50000, 64});
+
+// Counts elements straight from the parser callbacks
+class CCountingHandler : public CXMLHandler{
+    public:
+        std::size_t DEntities = 0;
+
+        bool StartElement(const SXMLEntityView &entity) override{
+            DEntities++;
+            return true;
+        }
+        bool EndElement(const SXMLEntityView &entity) override{
+            DEntities++;
+            return true;
+        }
+        bool CharData(std::string_view text) override{
+            DEntities++;
+            return true;
+        }
+};
+
+static void BM_XMLParseHandler(benchmark::State &state){
+    std::string Input = BenchGenerators::AttributeXML(state.range(0), state.range(1));
+    std::size_t Entities = 0;
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+        CCountingHandler Handler;
+        uint64_t Start = AllocationCount();
+        Reader.Parse(Handler);
+        Allocations += AllocationCount() - Start;
+        Entities = Handler.DEntities;
+    }
+    ReportThroughput(state, Input.size(), Entities, Allocations);
+}
+BENCHMARK(BM_XMLParseHandler)->Args({10000, 24});
+
+static void BM_XMLDocumentLoad(benchmark::State &state){
+    std::string Input = BenchGenerators::AttributeXML(state.range(0), state.range(1));
+    std::size_t Nodes = 0;
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+        CXMLDocument Document;
+        uint64_t Start = AllocationCount();
+        Document.Load(Reader);
+        Allocations += AllocationCount() - Start;
+        Nodes = Document.NodeCount();
+    }
+    ReportThroughput(state, Input.size(), Nodes, Allocations);
+}
+BENCHMARK(BM_XMLDocumentLoad)->Args({10000, 24});
+
+// Rows are the records visited, each looking up its last attribute
+static void BM_XMLDocumentTraverse(benchmark::State &state){
+    std::string Input = BenchGenerators::AttributeXML(state.range(0), state.range(1));
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+    CXMLDocument Document;
+    Document.Load(Reader);
+    uint32_t Record = Document.Atom("record");
+    uint32_t Attribute = Document.Atom("attr" + std::to_string(state.range(1) - 1));
+    std::size_t Records = 0;
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        std::size_t Length = 0;
+        Records = 0;
+        uint64_t Start = AllocationCount();
+        for(uint32_t Node = Document.FirstChild(Document.Root(), Record); Node != CXMLDocument::InvalidNode; Node = Document.NextSibling(Node, Record)){
+            Length += Document.AttributeValue(Node, Attribute).size();
+            Records++;
+        }
+        Allocations += AllocationCount() - Start;
+        benchmark::DoNotOptimize(Length);
+    }
+    ReportThroughput(state, Input.size(), Records, Allocations);
+}
+BENCHMARK(BM_XMLDocumentTraverse)->Args({10000, 24});
+
+static void BM_XMLWrite(benchmark::State &state){
+    std::vector<SXMLEntity> Entities;
+    CXMLReader Reader(std::make_shared<CStringDataSource>(BenchGenerators::AttributeXML(state.range(0), state.range(1))));
+    SXMLEntity Entity;
+    while(Reader.ReadEntity(Entity)){
+        Entities.push_back(Entity);
+    }
+    std::size_t Bytes = 0;
+    uint64_t Allocations = 0;
+    for(auto _ : state){
+        auto Sink = std::make_shared<CStringDataSink>();
+        CXMLWriter Writer(Sink);
+        uint64_t Start = AllocationCount();
+        for(auto &Entity : Entities){
+            Writer.WriteEntity(Entity);
+        }
+        Writer.Flush();
+        Allocations += AllocationCount() - Start;
+        Bytes = Sink->String().size();
+    }
+    ReportThroughput(state, Bytes, Entities.size(), Allocations);
+}
+BENCHMARK(BM_XMLWrite)->Args({10000, 24});
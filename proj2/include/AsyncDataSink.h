@@ -0,0 +1,30 @@
+#ifndef ASYNCDATASINK_H
+#define ASYNCDATASINK_H
+
+#include <memory>
+#include "DataSink.h"
+
+// Writes to another sink on a background thread. Output collects in one
+// buffer while the thread drains the other, so formatting overlaps the
+// writes. Write errors are reported by a later call or by Flush.
+class CAsyncDataSink : public CDataSink{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+    public:
+        static constexpr std::size_t DefaultBufferSize = 65536;
+
+        CAsyncDataSink(std::shared_ptr< CDataSink > sink, std::size_t buffersize = DefaultBufferSize);
+        // Flushes pending data
+        ~CAsyncDataSink();
+
+        // Waits until all data has been handed to the wrapped sink
+        bool Flush() noexcept;
+
+        bool Put(const char &ch) noexcept override;
+        bool Write(const std::vector<char> &buf) noexcept override;
+        char *Reserve(std::size_t count) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
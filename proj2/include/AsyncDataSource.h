@@ -0,0 +1,27 @@
+#ifndef ASYNCDATASOURCE_H
+#define ASYNCDATASOURCE_H
+
+#include <memory>
+#include "DataSource.h"
+
+// Reads ahead from another source on a background thread. One buffer is
+// consumed while the thread fills the other, so parsing overlaps the reads.
+class CAsyncDataSource : public CDataSource{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+    public:
+        static constexpr std::size_t DefaultBufferSize = 65536;
+
+        CAsyncDataSource(std::shared_ptr< CDataSource > src, std::size_t buffersize = DefaultBufferSize);
+        ~CAsyncDataSource();
+
+        bool End() const noexcept override;
+        bool Get(char &ch) noexcept override;
+        bool Peek(char &ch) noexcept override;
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override;
+        bool Borrow(const char *&data, std::size_t &length) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef DSVCOLUMNBATCH_H
+#define DSVCOLUMNBATCH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One column of a batch of DSV rows. String columns keep all of their values
+// back to back in DArena with DOffsets[Row] .. DOffsets[Row + 1] delimiting
+// each value. Typed columns store parsed values, DValid marks the rows that
+// had a field that converted.
+struct SDSVColumn{
+    enum class EType{String, Int64, Double};
+    EType DType = EType::String;
+    std::string DArena;
+    std::vector< std::size_t > DOffsets;
+    std::vector< int64_t > DInt64Values;
+    std::vector< double > DDoubleValues;
+    std::vector< uint8_t > DValid;
+
+    std::string_view StringValue(std::size_t row) const{
+        return std::string_view(DArena.data() + DOffsets[row], DOffsets[row + 1] - DOffsets[row]);
+    };
+
+    bool Valid(std::size_t row) const{
+        return DValid[row] != 0;
+    };
+
+    void Clear(){
+        DArena.clear();
+        DOffsets.assign(1, 0);
+        DInt64Values.clear();
+        DDoubleValues.clear();
+        DValid.clear();
+    };
+};
+
+struct SDSVColumnBatch{
+    std::size_t DRowCount = 0;
+    std::vector< SDSVColumn > DColumns;
+
+    // Keeps column types and storage capacity for reuse
+    void Clear(){
+        DRowCount = 0;
+        for(auto &Column : DColumns){
+            Column.Clear();
+        }
+    };
+};
+
+#endif
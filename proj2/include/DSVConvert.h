@@ -0,0 +1,21 @@
+#ifndef DSVCONVERT_H
+#define DSVCONVERT_H
+
+#include <cstdint>
+#include <string_view>
+
+// Converts DSV field text directly to values without exceptions or locales
+namespace DSVConvert{
+
+enum class EResult{Ok, Empty, Invalid, OutOfRange};
+
+EResult ParseInt64(std::string_view str, int64_t &value) noexcept;
+EResult ParseDouble(std::string_view str, double &value) noexcept;
+// Accepts true/false in any case, and 1/0
+EResult ParseBool(std::string_view str, bool &value) noexcept;
+// Accepts YYYY-MM-DD, value is the number of days since 1970-01-01
+EResult ParseDate(std::string_view str, int64_t &days) noexcept;
+
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef DSVPARALLELREADER_H
+#define DSVPARALLELREADER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "DataSource.h"
+
+// Reads the same rows as CDSVReader, but splits large source windows into
+// chunks that are parsed on a pool of threads. Quote state at each chunk
+// start is resolved from the quote parity of the preceding chunks so rows
+// are never split incorrectly. Sources that only expose small windows are
+// read sequentially.
+class CDSVParallelReader{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+
+    public:
+        static constexpr std::size_t DefaultChunkSize = 1 << 20;
+
+        // threads of 0 uses the hardware concurrency
+        CDSVParallelReader(std::shared_ptr< CDataSource > src, char delimiter, std::size_t threads = 0, std::size_t chunksize = DefaultChunkSize);
+        ~CDSVParallelReader();
+
+        bool End() const;
+        bool ReadRow(std::vector<std::string> &row);
+};
+
+#endif
@@ -3,7 +3,11 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "DataSource.h"
+#include "IOStats.h"
+#include "DSVColumnBatch.h"
 
 class CDSVReader{
     private:
@@ -16,6 +20,16 @@ class CDSVReader{
 
         bool End() const;
         bool ReadRow(std::vector<std::string> &row);
+        // Fields point into the source window when possible, or into reader
+        // owned storage for fields that need unescaping. They remain valid
+        // until the next read, End() does not consume from the source.
+        bool ReadRowView(std::vector<std::string_view> &row);
+        // Reads up to maxrows rows into batch, keeping the column types set by
+        // the caller. Columns are added as strings for wider rows. Returns the
+        // number of rows read.
+        std::size_t ReadBatch(SDSVColumnBatch &batch, std::size_t maxrows);
+        // Counters collected when built with -DIOSTATS
+        SIOStats Stats() const;
 };
 
 #endif
@@ -0,0 +1,34 @@
+#ifndef DSVSCANNER_H
+#define DSVSCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized character class scanning used by the DSV readers. The best
+// implementation (AVX2, SSE2 or scalar) is selected at runtime on first use.
+namespace DSVScanner{
+
+// Index of the first delimiter, quote, CR or LF in data, or length if none
+std::size_t FindSpecial(const char *data, std::size_t length, char delimiter) noexcept;
+
+// Index of the first quote in data, or length if none
+std::size_t FindQuote(const char *data, std::size_t length) noexcept;
+
+// Number of quotes in data
+std::size_t CountQuotes(const char *data, std::size_t length) noexcept;
+
+// Classifies a 64 character block into bit masks of quote positions and of
+// delimiter, CR and LF positions
+void ClassifyBlock(const char *block, char delimiter, uint64_t &quotes, uint64_t &separators) noexcept;
+
+// Returns the mask of separators in a 64 character block that are outside of
+// quotes. inquote is all ones when the block starts inside quotes and is
+// updated to the state at the end of the block.
+uint64_t StructuralMask(const char *block, char delimiter, uint64_t &inquote) noexcept;
+
+// Name of the selected implementation, "avx2", "sse2" or "scalar"
+const char *Implementation() noexcept;
+
+}
+
+#endif
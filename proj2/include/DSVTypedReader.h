@@ -0,0 +1,47 @@
+#ifndef DSVTYPEDREADER_H
+#define DSVTYPEDREADER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DataSource.h"
+#include "DSVConvert.h"
+
+struct SDSVTypedField{
+    enum class EType{String, Int, Double, Bool, Date};
+    EType DType;
+    // Ok when the field converted, Empty when it was empty or missing
+    DSVConvert::EResult DResult;
+    // Int values, and dates as days since 1970-01-01
+    int64_t DInt;
+    double DDouble;
+    bool DBool;
+    // Text of the field, valid until the next read
+    std::string_view DString;
+
+    bool Valid() const{
+        return DResult == DSVConvert::EResult::Ok;
+    };
+};
+
+// Reads DSV rows converting each column to the type declared in the schema.
+// Conversion failures are reported per field rather than aborting the row.
+class CDSVTypedReader{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+
+    public:
+        CDSVTypedReader(std::shared_ptr< CDataSource > src, char delimiter, const std::vector< SDSVTypedField::EType > &schema);
+        ~CDSVTypedReader();
+
+        bool End() const;
+        // row always holds one field per schema column, extra fields are ignored
+        bool ReadRow(std::vector< SDSVTypedField > &row);
+        // Number of fields in the last row that did not convert
+        std::size_t ErrorCount() const;
+};
+
+#endif
@@ -3,7 +3,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "DataSink.h"
+#include "IOStats.h"
 
 class CDSVWriter{
     private:
@@ -15,6 +17,12 @@ class CDSVWriter{
         ~CDSVWriter();
 
         bool WriteRow(const std::vector<std::string> &row);
+        // Formats all rows into one sink reservation
+        bool WriteRows(const std::vector< std::vector<std::string> > &rows);
+        // Appends the formatted rows to buf and returns the length appended
+        std::size_t FormatRows(const std::vector< std::vector<std::string> > &rows, std::string &buf);
+        // Counters collected when built with -DIOSTATS
+        SIOStats Stats() const;
 };
 
 #endif
@@ -1,13 +1,53 @@
 #ifndef DATASINK_H
 #define DATASINK_H
 
+#include <cstddef>
+#include <cstring>
 #include <vector>
 
 class CDataSink{
+    private:
+        std::vector<char> DReserved;
+        bool DReserving = false;
     public:
         virtual ~CDataSink(){};
         virtual bool Put(const char &ch) noexcept = 0;
         virtual bool Write(const std::vector<char> &buf) noexcept = 0;
+
+        // Returns space for at least count characters that is handed to the
+        // sink by Commit. The default stages through a scratch buffer that is
+        // passed to Write, sinks with their own buffer should write in place.
+        virtual char *Reserve(std::size_t count) noexcept{
+            DReserved.resize(count);
+            DReserving = true;
+            return DReserved.data();
+        };
+
+        // Appends length characters with a single Reserve and Commit
+        bool WriteBlock(const char *data, std::size_t length) noexcept{
+            if(!length){
+                return true;
+            }
+            char *Buffer = Reserve(length);
+            if(!Buffer){
+                return false;
+            }
+            std::memcpy(Buffer, data, length);
+            return Commit(length);
+        };
+
+        // Appends the first count characters of the last Reserve, fails if
+        // that was already committed
+        virtual bool Commit(std::size_t count) noexcept{
+            if(!DReserving || (count > DReserved.size())){
+                return false;
+            }
+            DReserving = false;
+            DReserved.resize(count);
+            bool Result = count ? Write(DReserved) : true;
+            DReserved.clear();
+            return Result;
+        };
 };
 
 #endif
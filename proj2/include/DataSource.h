@@ -1,15 +1,43 @@
 #ifndef DATASOURCE_H
 #define DATASOURCE_H
 
+#include <cstddef>
 #include <vector>
 
 class CDataSource{
+    private:
+        char DBorrowed;
     public:
         virtual ~CDataSource(){};
         virtual bool End() const noexcept = 0;
         virtual bool Get(char &ch) noexcept = 0;
         virtual bool Peek(char &ch) noexcept = 0;
         virtual bool Read(std::vector<char> &buf, std::size_t count) noexcept = 0;
+
+        // Exposes a contiguous window of unconsumed data without consuming it.
+        // The window stays valid until the next call that consumes or borrows.
+        // The default only exposes the next character, sources that hold their
+        // data in memory should override this to expose whole blocks.
+        virtual bool Borrow(const char *&data, std::size_t &length) noexcept{
+            if(!Peek(DBorrowed)){
+                length = 0;
+                return false;
+            }
+            data = &DBorrowed;
+            length = 1;
+            return true;
+        };
+
+        // Consumes count characters, normally after a Borrow
+        virtual bool Commit(std::size_t count) noexcept{
+            char TempChar;
+            while(count--){
+                if(!Get(TempChar)){
+                    return false;
+                }
+            }
+            return true;
+        };
 };
 
 #endif
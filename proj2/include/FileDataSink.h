@@ -0,0 +1,42 @@
+#ifndef FILEDATASINK_H
+#define FILEDATASINK_H
+
+#include "DataSink.h"
+#include <string>
+
+// Writes to a file descriptor through a user space buffer. Writes that do
+// not fit in the buffer are sent together with the buffered data in a single
+// writev() call. Data is flushed on Flush, Close and destruction.
+class CFileDataSink : public CDataSink{
+    private:
+        int DFileDescriptor;
+        bool DOwnsDescriptor;
+        std::vector<char> DBuffer;
+        std::size_t DLength;
+        // Reservations larger than DBuffer, released by the next Commit
+        std::vector<char> DOverflow;
+        bool DReserving;
+        bool DError;
+
+        bool WriteBuffered(const char *data, std::size_t length) noexcept;
+        void DropReservation() noexcept;
+    public:
+        static constexpr std::size_t DefaultBufferSize = 65536;
+
+        CFileDataSink(const std::string &path, bool append = false, std::size_t buffersize = DefaultBufferSize);
+        CFileDataSink(int fd, bool closefd = false, std::size_t buffersize = DefaultBufferSize);
+        CFileDataSink(const CFileDataSink &) = delete;
+        CFileDataSink &operator=(const CFileDataSink &) = delete;
+        ~CFileDataSink();
+
+        bool IsOpen() const noexcept;
+        bool Flush() noexcept;
+        bool Close() noexcept;
+
+        bool Put(const char &ch) noexcept override;
+        bool Write(const std::vector<char> &buf) noexcept override;
+        char *Reserve(std::size_t count) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef GZIPDATASINK_H
+#define GZIPDATASINK_H
+
+#include <memory>
+#include "DataSink.h"
+
+// Compresses to gzip and writes the result to another sink. With more than
+// one thread, blocks of input are compressed in parallel on a pool of
+// threads kept for the life of the sink, as independent gzip members which
+// any gzip reader decodes as a single stream. The stream is finished by
+// Close or on destruction.
+class CGzipDataSink : public CDataSink{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+    public:
+        static constexpr std::size_t DefaultBlockSize = 131072;
+        static constexpr int DefaultLevel = 6;
+
+        CGzipDataSink(std::shared_ptr< CDataSink > sink, int level = DefaultLevel, std::size_t threads = 1, std::size_t blocksize = DefaultBlockSize);
+        ~CGzipDataSink();
+
+        bool Close() noexcept;
+
+        bool Put(const char &ch) noexcept override;
+        bool Write(const std::vector<char> &buf) noexcept override;
+        char *Reserve(std::size_t count) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
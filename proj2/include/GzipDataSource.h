@@ -0,0 +1,31 @@
+#ifndef GZIPDATASOURCE_H
+#define GZIPDATASOURCE_H
+
+#include <memory>
+#include "DataSource.h"
+
+// Decompresses a gzip or zlib stream read from another source. Input is
+// inflated a block at a time as it is consumed, concatenated gzip members
+// are read as one stream. Corrupt or truncated input ends the source early
+// and is reported by HasError.
+class CGzipDataSource : public CDataSource{
+    private:
+        struct SImplementation;
+        std::unique_ptr<SImplementation> DImplementation;
+    public:
+        static constexpr std::size_t DefaultBufferSize = 65536;
+
+        CGzipDataSource(std::shared_ptr< CDataSource > src, std::size_t buffersize = DefaultBufferSize);
+        ~CGzipDataSource();
+
+        bool HasError() const noexcept;
+
+        bool End() const noexcept override;
+        bool Get(char &ch) noexcept override;
+        bool Peek(char &ch) noexcept override;
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override;
+        bool Borrow(const char *&data, std::size_t &length) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef IOSTATS_H
+#define IOSTATS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include "DataSink.h"
+#include "DataSource.h"
+
+#if defined(IOSTATS) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif defined(IOSTATS)
+#include <chrono>
+#endif
+
+// Runtime counters of the readers and writers. They are only collected when
+// compiled with -DIOSTATS, otherwise the counting code is compiled out and
+// the stats stay zero.
+struct SIOStats{
+#ifdef IOSTATS
+    static constexpr bool Enabled = true;
+#else
+    static constexpr bool Enabled = false;
+#endif
+    // Bytes consumed from the source or produced to the sink
+    uint64_t DBytes = 0;
+    // Rows or entities read or written
+    uint64_t DRecords = 0;
+    // Calls made on the source or sink
+    uint64_t DCalls = 0;
+    // Chunks passed to Expat
+    uint64_t DChunks = 0;
+    // Most parsed entities waiting in the queue at once
+    uint64_t DQueueHighWater = 0;
+    // Times an internal buffer had to grow
+    uint64_t DAllocations = 0;
+    // Cycles spent in source or sink calls
+    uint64_t DIOCycles = 0;
+    // Cycles spent parsing, or formatting and escaping, outside of I/O
+    uint64_t DProcessCycles = 0;
+};
+
+#ifdef IOSTATS
+
+#define IOSTATS_ONLY(...) __VA_ARGS__
+
+inline uint64_t IOStatsCycles() noexcept{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// Stats together with the state used while collecting them
+struct SIOStatsCollector{
+    SIOStats DStats;
+    unsigned DDepth = 0;
+
+    SIOStats Snapshot() const noexcept{
+        SIOStats Result = DStats;
+        Result.DProcessCycles -= std::min(Result.DProcessCycles, Result.DIOCycles);
+        return Result;
+    };
+};
+
+// Times a public call, nested calls are included in the outermost one
+class CIOStatsScope{
+    private:
+        SIOStatsCollector &DCollector;
+        uint64_t DStart;
+    public:
+        CIOStatsScope(SIOStatsCollector &collector) noexcept : DCollector(collector), DStart(IOStatsCycles()){
+            DCollector.DDepth++;
+        };
+        ~CIOStatsScope(){
+            if(!--DCollector.DDepth){
+                DCollector.DStats.DProcessCycles += IOStatsCycles() - DStart;
+            }
+        };
+};
+
+#define IOSTATS_SCOPE(collector) CIOStatsScope IOStatsScope(collector)
+
+// Growth of a container are counted by comparing its capacity around a change
+#define IOSTATS_TRACK_GROWTH(collector, container, ...) \
+    do{ \
+        auto IOStatsCapacity = (container).capacity(); \
+        __VA_ARGS__; \
+        (collector).DStats.DAllocations += (container).capacity() != IOStatsCapacity; \
+    }while(false)
+
+// Forwards to a source while counting calls, consumed bytes and cycles
+class CIOStatsDataSource : public CDataSource{
+    private:
+        std::shared_ptr< CDataSource > DSource;
+        SIOStats &DStats;
+
+        template <typename TCall> auto Timed(TCall call) const noexcept{
+            uint64_t Start = IOStatsCycles();
+            auto Result = call();
+            DStats.DCalls++;
+            DStats.DIOCycles += IOStatsCycles() - Start;
+            return Result;
+        };
+    public:
+        CIOStatsDataSource(std::shared_ptr< CDataSource > src, SIOStats &stats) : DSource(src), DStats(stats){};
+
+        bool End() const noexcept override{
+            return Timed([&]{ return DSource->End(); });
+        };
+        bool Get(char &ch) noexcept override{
+            bool Result = Timed([&]{ return DSource->Get(ch); });
+            DStats.DBytes += Result;
+            return Result;
+        };
+        bool Peek(char &ch) noexcept override{
+            return Timed([&]{ return DSource->Peek(ch); });
+        };
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override{
+            bool Result = Timed([&]{ return DSource->Read(buf, count); });
+            DStats.DBytes += buf.size();
+            return Result;
+        };
+        bool Borrow(const char *&data, std::size_t &length) noexcept override{
+            return Timed([&]{ return DSource->Borrow(data, length); });
+        };
+        bool Commit(std::size_t count) noexcept override{
+            bool Result = Timed([&]{ return DSource->Commit(count); });
+            DStats.DBytes += Result ? count : 0;
+            return Result;
+        };
+};
+
+// Forwards to a sink while counting calls, produced bytes and cycles
+class CIOStatsDataSink : public CDataSink{
+    private:
+        std::shared_ptr< CDataSink > DSink;
+        SIOStats &DStats;
+
+        template <typename TCall> auto Timed(TCall call) noexcept{
+            uint64_t Start = IOStatsCycles();
+            auto Result = call();
+            DStats.DCalls++;
+            DStats.DIOCycles += IOStatsCycles() - Start;
+            return Result;
+        };
+    public:
+        CIOStatsDataSink(std::shared_ptr< CDataSink > sink, SIOStats &stats) : DSink(sink), DStats(stats){};
+
+        bool Put(const char &ch) noexcept override{
+            bool Result = Timed([&]{ return DSink->Put(ch); });
+            DStats.DBytes += Result;
+            return Result;
+        };
+        bool Write(const std::vector<char> &buf) noexcept override{
+            bool Result = Timed([&]{ return DSink->Write(buf); });
+            DStats.DBytes += Result ? buf.size() : 0;
+            return Result;
+        };
+        char *Reserve(std::size_t count) noexcept override{
+            return Timed([&]{ return DSink->Reserve(count); });
+        };
+        bool Commit(std::size_t count) noexcept override{
+            bool Result = Timed([&]{ return DSink->Commit(count); });
+            DStats.DBytes += Result ? count : 0;
+            return Result;
+        };
+};
+
+#else
+
+#define IOSTATS_ONLY(...)
+#define IOSTATS_SCOPE(collector)
+#define IOSTATS_TRACK_GROWTH(collector, container, ...) __VA_ARGS__
+
+struct SIOStatsCollector{
+    SIOStats Snapshot() const noexcept{
+        return SIOStats();
+    };
+};
+
+#endif
+
+#endif
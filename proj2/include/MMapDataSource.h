@@ -0,0 +1,47 @@
+#ifndef MMAPDATASOURCE_H
+#define MMAPDATASOURCE_H
+
+#include "DataSource.h"
+#include <string>
+
+// Reads a file through a read-only memory mapping so parsers can scan it in
+// place via Borrow. Descriptors that cannot be mapped (pipes, sockets, ttys)
+// and files reporting a size of zero fall back to buffered read() calls.
+class CMMapDataSource : public CDataSource{
+    private:
+        int DFileDescriptor;
+        bool DOwnsDescriptor;
+        char *DMapped;
+        std::size_t DMappedLength;
+        std::vector<char> DBuffer;
+        std::size_t DBufferLength;
+        std::size_t DIndex;
+        bool DEndOfFile;
+
+        void Open(std::size_t buffersize) noexcept;
+        void Fill() noexcept;
+        std::size_t Remaining() const noexcept;
+        const char *Current() const noexcept;
+    public:
+        static constexpr std::size_t DefaultBufferSize = 65536;
+
+        CMMapDataSource(const std::string &path, std::size_t buffersize = DefaultBufferSize);
+        CMMapDataSource(int fd, bool closefd = false, std::size_t buffersize = DefaultBufferSize);
+        CMMapDataSource(const CMMapDataSource &) = delete;
+        CMMapDataSource &operator=(const CMMapDataSource &) = delete;
+        ~CMMapDataSource();
+
+        bool IsOpen() const noexcept;
+        bool IsMapped() const noexcept;
+        const char *Data() const noexcept;
+        std::size_t Size() const noexcept;
+
+        bool End() const noexcept override;
+        bool Get(char &ch) noexcept override;
+        bool Peek(char &ch) noexcept override;
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override;
+        bool Borrow(const char *&data, std::size_t &length) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
+};
+
+#endif
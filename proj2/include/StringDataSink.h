@@ -7,11 +7,19 @@
 class CStringDataSink : public CDataSink{
     private:
         std::string DString;
+        size_t DReservedBase;
+        bool DReserving;
+
+        void DropReservation() noexcept;
     public:
+        CStringDataSink();
+
         const std::string &String() const;
 
         bool Put(const char &ch) noexcept override;
         bool Write(const std::vector<char> &buf) noexcept override;
+        char *Reserve(std::size_t count) noexcept override;
+        bool Commit(std::size_t count) noexcept override;
 };
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef STRINGREPLACER_H
+#define STRINGREPLACER_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Applies a whole table of substitutions in a single pass. The patterns are
+// compiled into an Aho-Corasick automaton, and at each position the leftmost
+// and then longest matching pattern is replaced. Replaced text is not
+// searched again, so the result does not depend on the table order except
+// for duplicate patterns, where the first entry wins.
+class CStringReplacer{
+    private:
+        static constexpr uint32_t NoPattern = UINT32_MAX;
+
+        // Dense transitions of the automaton, 256 per state
+        std::vector<uint32_t> DTransitions;
+        std::vector<uint32_t> DDepths;
+        // Longest pattern ending at each state
+        std::vector<uint32_t> DOutputs;
+        std::vector<std::string> DPatterns;
+        std::vector<std::string> DReplacements;
+        bool DStarts[256];
+
+        void Compile();
+    public:
+        CStringReplacer(std::initializer_list< std::pair< std::string_view, std::string_view > > replacements);
+        CStringReplacer(const std::vector< std::pair< std::string, std::string > > &replacements);
+
+        std::size_t PatternCount() const noexcept;
+        std::string Replace(std::string_view text) const;
+        void Append(std::string &str, std::string_view text) const;
+};
+
+#endif
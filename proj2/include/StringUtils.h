@@ -2,25 +2,105 @@
 #define STRINGUTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace StringUtils{
-    
-std::string Slice(const std::string &str, ssize_t start, ssize_t end=0) noexcept;
-std::string Capitalize(const std::string &str) noexcept;
-std::string Upper(const std::string &str) noexcept;
-std::string Lower(const std::string &str) noexcept;
-std::string LStrip(const std::string &str) noexcept;
-std::string RStrip(const std::string &str) noexcept;
-std::string Strip(const std::string &str) noexcept;
-std::string Center(const std::string &str, int width, char fill = ' ') noexcept;
-std::string LJust(const std::string &str, int width, char fill = ' ') noexcept;
-std::string RJust(const std::string &str, int width, char fill = ' ') noexcept;
-std::string Replace(const std::string &str, const std::string &old, const std::string &rep) noexcept;
-std::vector< std::string > Split(const std::string &str, const std::string &splt = "") noexcept;
-std::string Join(const std::string &str, const std::vector< std::string > &vect) noexcept;
-std::string ExpandTabs(const std::string &str, int tabsize = 4) noexcept;
-int EditDistance(const std::string &left, const std::string &right, bool ignorecase=false) noexcept;
+
+std::string Slice(std::string_view str, ssize_t start, ssize_t end=0) noexcept;
+std::string Capitalize(std::string_view str) noexcept;
+std::string Upper(std::string_view str) noexcept;
+std::string Lower(std::string_view str) noexcept;
+std::string LStrip(std::string_view str) noexcept;
+std::string RStrip(std::string_view str) noexcept;
+std::string Strip(std::string_view str) noexcept;
+std::string Center(std::string_view str, int width, char fill = ' ') noexcept;
+std::string LJust(std::string_view str, int width, char fill = ' ') noexcept;
+std::string RJust(std::string_view str, int width, char fill = ' ') noexcept;
+std::string Replace(std::string_view str, std::string_view old, std::string_view rep) noexcept;
+std::vector< std::string > Split(std::string_view str, std::string_view splt = "") noexcept;
+std::string Join(std::string_view str, const std::vector< std::string > &vect) noexcept;
+std::string ExpandTabs(std::string_view str, int tabsize = 4) noexcept;
+int EditDistance(std::string_view left, std::string_view right, bool ignorecase=false) noexcept;
+// Returns the distance if it is at most maxdistance, otherwise maxdistance + 1
+int BoundedEditDistance(std::string_view left, std::string_view right, int maxdistance, bool ignorecase=false) noexcept;
+
+struct SEditMatch{
+    std::size_t DIndex;
+    int DDistance;
+};
+
+// Candidates within maxdistance of query, in candidate order. The
+// candidates are divided between threads, 0 uses all hardware threads.
+std::vector< SEditMatch > FindMatches(std::string_view query, const std::vector< std::string > &candidates, int maxdistance, bool ignorecase=false, std::size_t threads=1) noexcept;
+
+// Views into str, they stay valid as long as the viewed characters do
+std::string_view SliceView(std::string_view str, ssize_t start, ssize_t end=0) noexcept;
+std::string_view LStripView(std::string_view str) noexcept;
+std::string_view RStripView(std::string_view str) noexcept;
+std::string_view StripView(std::string_view str) noexcept;
+// Replaces the contents of parts, returns the number of parts
+std::size_t SplitView(std::string_view str, std::vector< std::string_view > &parts, std::string_view splt = "") noexcept;
+
+// Variants that modify str or append to buf instead of returning a new string
+void UpperInPlace(std::string &str) noexcept;
+void LowerInPlace(std::string &str) noexcept;
+void StripInPlace(std::string &str) noexcept;
+void AppendUpper(std::string &buf, std::string_view str) noexcept;
+void AppendLower(std::string &buf, std::string_view str) noexcept;
+void AppendReplace(std::string &buf, std::string_view str, std::string_view old, std::string_view rep) noexcept;
+
+// Iterates the parts Split would return without storing them. An empty
+// separator splits on runs of whitespace.
+class CSplitIterator{
+    private:
+        std::string_view DRest;
+        std::string_view DSeparator;
+        std::string_view DCurrent;
+        bool DDone;
+
+        void Advance() noexcept;
+    public:
+        CSplitIterator() noexcept : DDone(true){};
+        CSplitIterator(std::string_view str, std::string_view splt) noexcept;
+
+        std::string_view operator*() const noexcept{
+            return DCurrent;
+        };
+        const std::string_view *operator->() const noexcept{
+            return &DCurrent;
+        };
+        CSplitIterator &operator++() noexcept{
+            Advance();
+            return *this;
+        };
+        bool operator==(const CSplitIterator &other) const noexcept{
+            return DDone == other.DDone && (DDone || DCurrent.data() == other.DCurrent.data());
+        };
+        bool operator!=(const CSplitIterator &other) const noexcept{
+            return !(*this == other);
+        };
+};
+
+class CSplitRange{
+    private:
+        std::string_view DString;
+        std::string_view DSeparator;
+    public:
+        CSplitRange(std::string_view str, std::string_view splt) noexcept : DString(str), DSeparator(splt){};
+
+        CSplitIterator begin() const noexcept{
+            return CSplitIterator(DString, DSeparator);
+        };
+        CSplitIterator end() const noexcept{
+            return CSplitIterator();
+        };
+};
+
+// Lazily splits str, for example: for(auto Part : SplitRange(Line, ",")){...}
+inline CSplitRange SplitRange(std::string_view str, std::string_view splt = "") noexcept{
+    return CSplitRange(str, splt);
+}
 
 }
 
@@ -0,0 +1,34 @@
+#ifndef TEXTESCAPER_H
+#define TEXTESCAPER_H
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "DataSink.h"
+
+// Escapes text by replacing up to eight special characters. The special
+// characters are located with SSE2/AVX2 when available so runs of clean text
+// are copied in bulk and only the special characters are handled one by one.
+class CTextEscaper{
+    private:
+        std::string DReplacements[256];
+        char DSpecial[8];
+        std::size_t DSpecialCount;
+        std::size_t DMaxReplacement;
+    public:
+        static constexpr std::size_t MaxSpecial = 8;
+
+        CTextEscaper(std::initializer_list< std::pair< char, std::string_view > > replacements);
+
+        // Index of the first special character in data, or length if none
+        std::size_t FindSpecial(const char *data, std::size_t length) const noexcept;
+        std::size_t EscapedLength(std::string_view text) const noexcept;
+        // Writes escaped text into buf, which must hold EscapedLength(text)
+        // characters. Returns the number of characters written.
+        std::size_t Escape(std::string_view text, char *buf) const noexcept;
+        void Append(std::string &str, std::string_view text) const;
+        bool Write(CDataSink &sink, std::string_view text) const noexcept;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs numbered tasks on persistent worker threads and the calling thread
+class CWorkerPool{
+    private:
+        std::vector<std::thread> DThreads;
+        std::mutex DMutex;
+        std::condition_variable DStart;
+        std::condition_variable DDone;
+        std::function<void(std::size_t)> DTask;
+        std::size_t DTaskCount;
+        std::atomic<std::size_t> DNextTask;
+        std::size_t DActive;
+        std::size_t DGeneration;
+        bool DStop;
+
+        void RunTasks();
+        void Worker();
+    public:
+        // Starts threads - 1 workers, the caller of Run is the last one
+        CWorkerPool(std::size_t threads);
+        ~CWorkerPool();
+
+        std::size_t Size() const;
+        // Calls task with every index below count and returns when all are done
+        void Run(std::size_t count, std::function<void(std::size_t)> task);
+};
+
+#endif
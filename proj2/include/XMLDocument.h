@@ -0,0 +1,132 @@
+#ifndef XMLDOCUMENT_H
+#define XMLDOCUMENT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "XMLNameTable.h"
+#include "XMLReader.h"
+
+// Read only tree of a document stored in flat arrays. Nodes are numbered in
+// document order and linked by index, element and attribute names are
+// interned atoms, and all text and attribute values share one arena, so the
+// whole tree takes a handful of allocations and the descendants of a node are
+// the contiguous range [node + 1, SubtreeEnd(node)).
+class CXMLDocument{
+    private:
+        struct SString{
+            uint32_t DOffset;
+            uint32_t DLength;
+        };
+
+        struct SNode{
+            uint32_t DParent;
+            uint32_t DFirstChild;
+            uint32_t DNextSibling;
+            // InvalidAtom for text
+            uint32_t DNameAtom;
+            // Attributes of elements
+            uint32_t DFirstAttribute;
+            uint32_t DAttributeCount;
+            // Text of text nodes
+            SString DText;
+        };
+
+        struct SAttribute{
+            uint32_t DNameAtom;
+            SString DValue;
+        };
+
+        class CBuilder;
+
+        std::vector< SNode > DNodes;
+        std::vector< SAttribute > DAttributes;
+        std::string DArena;
+        CXMLNameTable DNames;
+
+        std::string_view View(const SString &str) const noexcept{
+            return std::string_view(DArena.data() + str.DOffset, str.DLength);
+        };
+    public:
+        static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+        CXMLDocument() = default;
+        CXMLDocument(const CXMLDocument &) = delete;
+        CXMLDocument(CXMLDocument &&) = default;
+        CXMLDocument &operator=(const CXMLDocument &) = delete;
+        CXMLDocument &operator=(CXMLDocument &&) = default;
+
+        // Replaces the contents with the rest of the document in reader,
+        // returns false if it is malformed. Adjacent character data is merged
+        // into one text node, keeping any whitespace inside it. Text that is
+        // only whitespace is left out like ReadEntity does, and skipcdata
+        // leaves out all text.
+        bool Load(CXMLReader &reader, bool skipcdata = false);
+        void Clear() noexcept;
+
+        std::size_t NodeCount() const noexcept{
+            return DNodes.size();
+        };
+        // The first top level element, InvalidNode if empty
+        uint32_t Root() const noexcept{
+            return DNodes.empty() ? InvalidNode : 0;
+        };
+        // Atom of a name for the lookups below, InvalidAtom if no element
+        // or attribute in the document has that name
+        uint32_t Atom(std::string_view name) const noexcept{
+            return DNames.Find(name);
+        };
+
+        bool IsElement(uint32_t node) const noexcept{
+            return DNodes[node].DNameAtom != CXMLNameTable::InvalidAtom;
+        };
+        uint32_t NameAtom(uint32_t node) const noexcept{
+            return DNodes[node].DNameAtom;
+        };
+        std::string_view Name(uint32_t node) const noexcept{
+            return DNames.Name(DNodes[node].DNameAtom);
+        };
+        // Empty for elements
+        std::string_view Text(uint32_t node) const noexcept{
+            return IsElement(node) ? std::string_view() : View(DNodes[node].DText);
+        };
+        // Concatenated text of all descendants
+        std::string TextContent(uint32_t node) const;
+
+        uint32_t Parent(uint32_t node) const noexcept{
+            return DNodes[node].DParent;
+        };
+        uint32_t FirstChild(uint32_t node) const noexcept{
+            return DNodes[node].DFirstChild;
+        };
+        uint32_t NextSibling(uint32_t node) const noexcept{
+            return DNodes[node].DNextSibling;
+        };
+        // Child or sibling elements with the name atom
+        uint32_t FirstChild(uint32_t node, uint32_t atom) const noexcept;
+        uint32_t NextSibling(uint32_t node, uint32_t atom) const noexcept;
+        // One past the last descendant of node
+        uint32_t SubtreeEnd(uint32_t node) const noexcept;
+
+        std::size_t AttributeCount(uint32_t node) const noexcept{
+            return IsElement(node) ? DNodes[node].DAttributeCount : 0;
+        };
+        std::string_view AttributeNameAt(uint32_t node, std::size_t index) const noexcept{
+            return DNames.Name(DAttributes[DNodes[node].DFirstAttribute + index].DNameAtom);
+        };
+        std::string_view AttributeValueAt(uint32_t node, std::size_t index) const noexcept{
+            return View(DAttributes[DNodes[node].DFirstAttribute + index].DValue);
+        };
+        bool AttributeExists(uint32_t node, uint32_t atom) const noexcept;
+        bool AttributeExists(uint32_t node, std::string_view name) const noexcept{
+            return AttributeExists(node, Atom(name));
+        };
+        // Empty if the attribute does not exist
+        std::string_view AttributeValue(uint32_t node, uint32_t atom) const noexcept;
+        std::string_view AttributeValue(uint32_t node, std::string_view name) const noexcept{
+            return AttributeValue(node, Atom(name));
+        };
+};
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef XMLENTITY_H
 #define XMLENTITY_H
 
+#include <cstdint>
+#include <functional>
 #include <utility>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct SXMLEntity{
@@ -11,34 +14,84 @@ struct SXMLEntity{
     EType DType;
     std::string DNameData;
     std::vector< TAttribute > DAttributes;
-    
-    bool AttributeExists(const std::string &name) const{
-        for(auto &Attribute : DAttributes){
-            if(std::get<0>(Attribute) == name){
-                return true;   
+
+    // Attribute name with its hash computed once, for repeated lookups
+    struct SAttributeKey{
+        std::string_view DName;
+        std::size_t DHash;
+
+        SAttributeKey(std::string_view name) : DName(name), DHash(std::hash< std::string_view >()(name)){};
+    };
+
+    // Hash index over the attributes of an entity, for entities with many
+    // attributes that are looked up repeatedly. It is built explicitly and
+    // has to be built again after the attributes of the entity change.
+    struct SAttributeIndex{
+        // Open addressing table of attribute positions plus one, zero is empty
+        std::vector< uint32_t > DSlots;
+
+        void Build(const SXMLEntity &entity){
+            std::size_t Size = 1;
+            while(Size < entity.DAttributes.size() * 2){
+                Size <<= 1;
             }
-        }
-        return false;
+            DSlots.assign(Size, 0);
+            for(std::size_t Index = 0; Index < entity.DAttributes.size(); Index++){
+                std::size_t Slot = std::hash< std::string_view >()(std::get<0>(entity.DAttributes[Index])) & (Size - 1);
+                while(DSlots[Slot]){
+                    Slot = (Slot + 1) & (Size - 1);
+                }
+                DSlots[Slot] = Index + 1;
+            }
+        };
+
+        const TAttribute *Find(const SXMLEntity &entity, const SAttributeKey &key) const{
+            if(DSlots.empty()){
+                return nullptr;
+            }
+            std::size_t Mask = DSlots.size() - 1;
+            for(std::size_t Slot = key.DHash & Mask; DSlots[Slot]; Slot = (Slot + 1) & Mask){
+                auto &Attribute = entity.DAttributes[DSlots[Slot] - 1];
+                if(std::get<0>(Attribute) == key.DName){
+                    return &Attribute;
+                }
+            }
+            return nullptr;
+        };
     };
-    
-    std::string AttributeValue(const std::string &name) const{
+
+    const TAttribute *FindAttribute(std::string_view name) const{
         for(auto &Attribute : DAttributes){
             if(std::get<0>(Attribute) == name){
-                return std::get<1>(Attribute);   
+                return &Attribute;
             }
         }
-        return std::string();
+        return nullptr;
+    };
+    
+    bool AttributeExists(std::string_view name) const{
+        return FindAttribute(name) != nullptr;
+    };
+    
+    std::string AttributeValue(std::string_view name) const{
+        auto Attribute = FindAttribute(name);
+        return Attribute ? std::get<1>(*Attribute) : std::string();
+    };
+
+    // Same as AttributeValue without copying, valid until the attributes change
+    std::string_view AttributeView(std::string_view name) const{
+        auto Attribute = FindAttribute(name);
+        return Attribute ? std::string_view(std::get<1>(*Attribute)) : std::string_view();
     };
     
     bool SetAttribute(const std::string &name, const std::string &value){
         if(name.empty()){
             return false;   
         }
-        for(std::vector< TAttribute >::size_type Index = 0; Index < DAttributes.size(); Index++){
-            if(std::get<0>(DAttributes[Index]) == name){
-                DAttributes[Index] = std::make_pair(name,value);
-                return true;
-            }
+        auto Attribute = FindAttribute(name);
+        if(Attribute){
+            DAttributes[Attribute - DAttributes.data()].second = value;
+            return true;
         }
         DAttributes.push_back(std::make_pair(name,value));
         return true;
@@ -0,0 +1,53 @@
+#ifndef XMLENTITYVIEW_H
+#define XMLENTITYVIEW_H
+
+#include <cstdint>
+#include <string_view>
+#include "XMLEntity.h"
+#include "XMLNameTable.h"
+
+struct SXMLAttributeView{
+    uint32_t DNameAtom;
+    std::string_view DName;
+    std::string_view DValue;
+};
+
+// Entity whose names are interned atoms and whose text and attributes point
+// into reader owned storage. Valid until the next read from the reader.
+struct SXMLEntityView{
+    SXMLEntity::EType DType;
+    // InvalidAtom for character data
+    uint32_t DNameAtom;
+    std::string_view DNameData;
+    const SXMLAttributeView *DAttributes;
+    std::size_t DAttributeCount;
+
+    const SXMLAttributeView *FindAttribute(uint32_t atom) const{
+        for(std::size_t Index = 0; Index < DAttributeCount; Index++){
+            if(DAttributes[Index].DNameAtom == atom){
+                return DAttributes + Index;
+            }
+        }
+        return nullptr;
+    };
+
+    const SXMLAttributeView *FindAttribute(std::string_view name) const{
+        for(std::size_t Index = 0; Index < DAttributeCount; Index++){
+            if(DAttributes[Index].DName == name){
+                return DAttributes + Index;
+            }
+        }
+        return nullptr;
+    };
+
+    bool AttributeExists(std::string_view name) const{
+        return FindAttribute(name) != nullptr;
+    };
+
+    std::string_view AttributeValue(std::string_view name) const{
+        auto Attribute = FindAttribute(name);
+        return Attribute ? Attribute->DValue : std::string_view();
+    };
+};
+
+#endif
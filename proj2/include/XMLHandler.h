@@ -0,0 +1,25 @@
+#ifndef XMLHANDLER_H
+#define XMLHANDLER_H
+
+#include <string_view>
+#include "XMLEntityView.h"
+
+// Receives the entities of a document as CXMLReader::Parse reads them. The
+// views point into parser owned storage and are only valid during the call.
+// Character data comes in the pieces Expat reports, including the whitespace
+// only ones that ReadEntity drops. Returning false stops parsing.
+class CXMLHandler{
+    public:
+        virtual ~CXMLHandler(){};
+        virtual bool StartElement(const SXMLEntityView &entity){
+            return true;
+        };
+        virtual bool EndElement(const SXMLEntityView &entity){
+            return true;
+        };
+        virtual bool CharData(std::string_view text){
+            return true;
+        };
+};
+
+#endif
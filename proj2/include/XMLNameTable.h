@@ -0,0 +1,26 @@
+#ifndef XMLNAMETABLE_H
+#define XMLNAMETABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Interns element and attribute names as small integer atoms. Interned names
+// are stored once and their views stay valid for the life of the table.
+class CXMLNameTable{
+    private:
+        std::deque< std::string > DNames;
+        std::unordered_map< std::string_view, uint32_t > DAtoms;
+    public:
+        static constexpr uint32_t InvalidAtom = UINT32_MAX;
+
+        uint32_t Intern(std::string_view name);
+        // Returns InvalidAtom if the name has not been interned
+        uint32_t Find(std::string_view name) const noexcept;
+        std::string_view Name(uint32_t atom) const noexcept;
+        std::size_t Size() const noexcept;
+};
+
+#endif
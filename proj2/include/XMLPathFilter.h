@@ -0,0 +1,50 @@
+#ifndef XMLPATHFILTER_H
+#define XMLPATHFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Compiled subset of XPath used by CXMLReader to select elements while
+// streaming. Paths are absolute and made of steps separated by / for a
+// child or // for a descendant. A step is an element name or *, followed by
+// any number of [@name] or [@name='value'] attribute predicates. Several
+// paths can be joined with |, for example "/osm/way/tag|//node[@id='1']".
+class CXMLPathFilter{
+    private:
+        struct SPredicate{
+            std::string DName;
+            std::string DValue;
+            bool DHasValue;
+        };
+
+        struct SStep{
+            bool DDescendant;
+            // Empty for *
+            std::string DName;
+            std::vector< SPredicate > DPredicates;
+            bool DLast;
+        };
+
+        std::vector< SStep > DSteps;
+        std::vector< uint32_t > DFirstSteps;
+
+        bool AddSinglePath(std::string_view path);
+    public:
+        // Adds the paths in expression, returns false and adds nothing if it
+        // is malformed
+        bool AddPath(std::string_view expression);
+        bool Empty() const noexcept;
+
+        // Evaluation, steps are identified by their index. The reader keeps
+        // the steps that may match at each depth, starting from FirstSteps.
+        const std::vector< uint32_t > &FirstSteps() const noexcept;
+        bool Descendant(uint32_t step) const noexcept;
+        bool Last(uint32_t step) const noexcept;
+        // attributes is the null terminated name and value array from Expat
+        bool Matches(uint32_t step, const char *name, const char **attributes) const noexcept;
+};
+
+#endif
@@ -3,7 +3,12 @@
 
 #include <memory>
 #include "XMLEntity.h"
+#include "XMLEntityView.h"
+#include "XMLHandler.h"
+#include "XMLNameTable.h"
+#include "XMLPathFilter.h"
 #include "DataSource.h"
+#include "IOStats.h"
 
 class CXMLReader{
     private:
@@ -11,11 +16,30 @@ class CXMLReader{
         std::unique_ptr<SImplementation> DImplementation;
         
     public:
-        CXMLReader(std::shared_ptr< CDataSource > src);
+        static constexpr std::size_t DefaultChunkSize = 4096;
+        static constexpr std::size_t DefaultMaxChunkSize = 1 << 20;
+
+        // The chunk passed to Expat starts at chunksize and doubles while the
+        // source keeps filling it, up to maxchunksize
+        CXMLReader(std::shared_ptr< CDataSource > src, std::size_t chunksize = DefaultChunkSize, std::size_t maxchunksize = DefaultMaxChunkSize);
         ~CXMLReader();
         
         bool End() const;
         bool ReadEntity(SXMLEntity &entity, bool skipcdata = false);
+        // Reads without copying, the view is valid until the next read
+        bool ReadEntityView(SXMLEntityView &entity, bool skipcdata = false);
+        // Passes the rest of the document to handler straight from the
+        // parser, without building entities. Returns false on malformed
+        // input or if the handler stopped, which also ends the reader.
+        bool Parse(CXMLHandler &handler, bool skipcdata = false);
+        // Only elements matching filter are read, with everything inside
+        // them. Other elements are skipped in the parser callbacks without
+        // building entities. Must be set before the first read.
+        void SetFilter(const CXMLPathFilter &filter);
+        // Names of the entities read so far, also used to intern lookup keys
+        CXMLNameTable &NameTable();
+        // Counters collected when built with -DIOSTATS
+        SIOStats Stats() const;
 };
 
 #endif
@@ -4,6 +4,7 @@
 #include <memory>
 #include "XMLEntity.h"
 #include "DataSink.h"
+#include "IOStats.h"
 
 class CXMLWriter{
     private:
@@ -16,6 +17,11 @@ class CXMLWriter{
         
         bool Flush();
         bool WriteEntity(const SXMLEntity &entity);
+        // Formats the entities into one sink reservation. Stops at the first
+        // end element that does not match, after writing those before it.
+        bool WriteEntities(const std::vector< SXMLEntity > &entities);
+        // Counters collected when built with -DIOSTATS
+        SIOStats Stats() const;
 };
 
 #endif
@@ -0,0 +1,144 @@
+#include "AsyncDataSink.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct CAsyncDataSink::SImplementation {
+    std::shared_ptr<CDataSink> DataSink;
+    size_t BufferSize;
+    // Front is owned by the producer, Pending by the writer thread while Busy
+    std::vector<char> Front;
+    std::vector<char> Pending;
+    size_t ReservedBase;
+    bool Reserving;
+    bool Busy;
+    std::atomic<bool> Error;
+    bool Stop;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::thread Writer;
+    
+    SImplementation(std::shared_ptr<CDataSink> sink, size_t buffersize)
+        : DataSink(sink), BufferSize(std::max<size_t>(buffersize, 1)), ReservedBase(0),
+          Reserving(false), Busy(false), Error(false), Stop(false) {
+        Front.reserve(BufferSize);
+        Pending.reserve(BufferSize);
+        Writer = std::thread(&SImplementation::Drain, this);
+    }
+    
+    ~SImplementation() {
+        HandOff();
+        WaitIdle();
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Stop = true;
+        }
+        Condition.notify_all();
+        Writer.join();
+    }
+    
+    void Drain() {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        while(true) {
+            Condition.wait(Lock, [this] { return Stop || Busy; });
+            if(Busy) {
+                Lock.unlock();
+                bool Result = DataSink->Write(Pending);
+                Pending.clear();
+                Lock.lock();
+                if(!Result) {
+                    Error = true;
+                }
+                Busy = false;
+                Condition.notify_all();
+            } else if(Stop) {
+                return;
+            }
+        }
+    }
+    
+    bool WaitIdle() {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        Condition.wait(Lock, [this] { return !Busy; });
+        return !Error;
+    }
+    
+    // Space reserved but not committed is not part of the data
+    void DropReservation() {
+        if(Reserving) {
+            Front.resize(ReservedBase);
+            Reserving = false;
+        }
+    }
+    
+    // Gives the filled front buffer to the writer thread once it is idle
+    bool HandOff() {
+        DropReservation();
+        if(Front.empty()) {
+            return !Error;
+        }
+        std::unique_lock<std::mutex> Lock(Mutex);
+        Condition.wait(Lock, [this] { return !Busy; });
+        std::swap(Front, Pending);
+        Busy = true;
+        Condition.notify_all();
+        return !Error;
+    }
+    
+    bool Append(const char *data, size_t length) {
+        DropReservation();
+        while(length) {
+            if(Front.size() == BufferSize && !HandOff()) {
+                return false;
+            }
+            size_t Length = std::min(length, BufferSize - Front.size());
+            Front.insert(Front.end(), data, data + Length);
+            data += Length;
+            length -= Length;
+        }
+        return !Error;
+    }
+};
+
+CAsyncDataSink::CAsyncDataSink(std::shared_ptr<CDataSink> sink, std::size_t buffersize)
+    : DImplementation(std::make_unique<SImplementation>(sink, buffersize)) {
+}
+
+CAsyncDataSink::~CAsyncDataSink() = default;
+
+bool CAsyncDataSink::Flush() noexcept {
+    return DImplementation->HandOff() && DImplementation->WaitIdle();
+}
+
+bool CAsyncDataSink::Put(const char &ch) noexcept {
+    return DImplementation->Append(&ch, 1);
+}
+
+bool CAsyncDataSink::Write(const std::vector<char> &buf) noexcept {
+    return DImplementation->Append(buf.data(), buf.size());
+}
+
+char *CAsyncDataSink::Reserve(std::size_t count) noexcept {
+    DImplementation->DropReservation();
+    if(DImplementation->Front.size() + count > DImplementation->BufferSize && !DImplementation->HandOff()) {
+        return nullptr;
+    }
+    DImplementation->ReservedBase = DImplementation->Front.size();
+    DImplementation->Front.resize(DImplementation->ReservedBase + count);
+    DImplementation->Reserving = true;
+    return DImplementation->Front.data() + DImplementation->ReservedBase;
+}
+
+bool CAsyncDataSink::Commit(std::size_t count) noexcept {
+    if(!DImplementation->Reserving || (DImplementation->ReservedBase + count > DImplementation->Front.size())) {
+        return false;
+    }
+    DImplementation->Front.resize(DImplementation->ReservedBase + count);
+    DImplementation->Reserving = false;
+    if(DImplementation->Front.size() >= DImplementation->BufferSize) {
+        return DImplementation->HandOff();
+    }
+    return !DImplementation->Error;
+}
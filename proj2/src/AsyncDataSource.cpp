@@ -0,0 +1,141 @@
+#include "AsyncDataSource.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct CAsyncDataSource::SImplementation {
+    std::shared_ptr<CDataSource> DataSource;
+    size_t BufferSize;
+    // Front is owned by the consumer, Back by the reader thread until BackReady
+    std::vector<char> Front;
+    std::vector<char> Back;
+    size_t FrontIndex;
+    bool BackReady;
+    bool SourceEnded;
+    bool Stop;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::thread Reader;
+    
+    SImplementation(std::shared_ptr<CDataSource> src, size_t buffersize)
+        : DataSource(src), BufferSize(std::max<size_t>(buffersize, 1)), FrontIndex(0),
+          BackReady(false), SourceEnded(false), Stop(false) {
+        Reader = std::thread(&SImplementation::ReadAhead, this);
+        SwapBuffers();
+    }
+    
+    ~SImplementation() {
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Stop = true;
+        }
+        Condition.notify_all();
+        Reader.join();
+    }
+    
+    void ReadAhead() {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        while(true) {
+            Condition.wait(Lock, [this] { return Stop || !BackReady; });
+            if(Stop) {
+                return;
+            }
+            Lock.unlock();
+            DataSource->Read(Back, BufferSize);
+            bool Ended = Back.empty() || DataSource->End();
+            Lock.lock();
+            BackReady = true;
+            SourceEnded = Ended;
+            Condition.notify_all();
+            if(Ended) {
+                return;
+            }
+        }
+    }
+    
+    // Takes the buffer filled by the reader thread once the front is consumed
+    void SwapBuffers() {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        Condition.wait(Lock, [this] { return BackReady || SourceEnded; });
+        if(!BackReady) {
+            Front.clear();
+            FrontIndex = 0;
+            return;
+        }
+        std::swap(Front, Back);
+        FrontIndex = 0;
+        BackReady = false;
+        Condition.notify_all();
+    }
+    
+    size_t Remaining() const {
+        return Front.size() - FrontIndex;
+    }
+    
+    void Advance(size_t count) {
+        FrontIndex += count;
+        if(!Remaining()) {
+            SwapBuffers();
+        }
+    }
+};
+
+CAsyncDataSource::CAsyncDataSource(std::shared_ptr<CDataSource> src, std::size_t buffersize)
+    : DImplementation(std::make_unique<SImplementation>(src, buffersize)) {
+}
+
+CAsyncDataSource::~CAsyncDataSource() = default;
+
+bool CAsyncDataSource::End() const noexcept {
+    return !DImplementation->Remaining();
+}
+
+bool CAsyncDataSource::Get(char &ch) noexcept {
+    if(!DImplementation->Remaining()) {
+        return false;
+    }
+    ch = DImplementation->Front[DImplementation->FrontIndex];
+    DImplementation->Advance(1);
+    return true;
+}
+
+bool CAsyncDataSource::Peek(char &ch) noexcept {
+    if(!DImplementation->Remaining()) {
+        return false;
+    }
+    ch = DImplementation->Front[DImplementation->FrontIndex];
+    return true;
+}
+
+bool CAsyncDataSource::Read(std::vector<char> &buf, std::size_t count) noexcept {
+    buf.clear();
+    while(buf.size() < count && DImplementation->Remaining()) {
+        size_t Length = std::min(count - buf.size(), DImplementation->Remaining());
+        const char *Data = DImplementation->Front.data() + DImplementation->FrontIndex;
+        buf.insert(buf.end(), Data, Data + Length);
+        DImplementation->Advance(Length);
+    }
+    return !buf.empty();
+}
+
+bool CAsyncDataSource::Borrow(const char *&data, std::size_t &length) noexcept {
+    length = DImplementation->Remaining();
+    if(!length) {
+        return false;
+    }
+    data = DImplementation->Front.data() + DImplementation->FrontIndex;
+    return true;
+}
+
+bool CAsyncDataSource::Commit(std::size_t count) noexcept {
+    while(count) {
+        size_t Length = std::min(count, DImplementation->Remaining());
+        if(!Length) {
+            return false;
+        }
+        DImplementation->Advance(Length);
+        count -= Length;
+    }
+    return true;
+}
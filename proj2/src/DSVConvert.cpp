@@ -0,0 +1,105 @@
+#include "DSVConvert.h"
+#include <charconv>
+
+namespace DSVConvert{
+
+namespace{
+
+template <typename T>
+EResult ParseNumber(std::string_view str, T &value) noexcept{
+    if(str.empty()){
+        return EResult::Empty;
+    }
+    const char *Begin = str.data();
+    const char *End = str.data() + str.size();
+    // from_chars rejects the leading plus that writers commonly emit
+    if((*Begin == '+') && (str.size() > 1) && (Begin[1] != '-')){
+        Begin++;
+    }
+    auto Result = std::from_chars(Begin, End, value);
+    if(Result.ec == std::errc::result_out_of_range){
+        return EResult::OutOfRange;
+    }
+    if((Result.ec != std::errc()) || (Result.ptr != End)){
+        return EResult::Invalid;
+    }
+    return EResult::Ok;
+}
+
+bool EqualsIgnoreCase(std::string_view str, std::string_view lower) noexcept{
+    if(str.size() != lower.size()){
+        return false;
+    }
+    for(std::size_t Index = 0; Index < str.size(); Index++){
+        char Character = str[Index];
+        if(('A' <= Character) && (Character <= 'Z')){
+            Character += 'a' - 'A';
+        }
+        if(Character != lower[Index]){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParseDigits(std::string_view str, int &value) noexcept{
+    value = 0;
+    for(char Character : str){
+        if((Character < '0') || ('9' < Character)){
+            return false;
+        }
+        value = value * 10 + (Character - '0');
+    }
+    return true;
+}
+
+}
+
+EResult ParseInt64(std::string_view str, int64_t &value) noexcept{
+    return ParseNumber(str, value);
+}
+
+EResult ParseDouble(std::string_view str, double &value) noexcept{
+    return ParseNumber(str, value);
+}
+
+EResult ParseBool(std::string_view str, bool &value) noexcept{
+    if(str.empty()){
+        return EResult::Empty;
+    }
+    if((str == "1") || EqualsIgnoreCase(str, "true")){
+        value = true;
+        return EResult::Ok;
+    }
+    if((str == "0") || EqualsIgnoreCase(str, "false")){
+        value = false;
+        return EResult::Ok;
+    }
+    return EResult::Invalid;
+}
+
+EResult ParseDate(std::string_view str, int64_t &days) noexcept{
+    if(str.empty()){
+        return EResult::Empty;
+    }
+    int Year, Month, Day;
+    if((str.size() != 10) || (str[4] != '-') || (str[7] != '-') || !ParseDigits(str.substr(0, 4), Year)
+        || !ParseDigits(str.substr(5, 2), Month) || !ParseDigits(str.substr(8, 2), Day)){
+        return EResult::Invalid;
+    }
+    static const int DaysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool LeapYear = ((Year % 4) == 0) && (((Year % 100) != 0) || ((Year % 400) == 0));
+    if((Month < 1) || (12 < Month) || (Day < 1) || (DaysInMonth[Month - 1] + ((Month == 2) && LeapYear) < Day)){
+        return EResult::OutOfRange;
+    }
+    // Days from civil date, counting years from March so leap days come last
+    Year -= Month <= 2;
+    int64_t Era = (Year >= 0 ? Year : Year - 399) / 400;
+    int64_t YearOfEra = Year - Era * 400;
+    int64_t DayOfYear = (153 * (Month + (Month > 2 ? -3 : 9)) + 2) / 5 + Day - 1;
+    int64_t DayOfEra = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+    days = Era * 146097 + DayOfEra - 719468;
+    return EResult::Ok;
+}
+
+}
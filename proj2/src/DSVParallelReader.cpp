@@ -0,0 +1,254 @@
+#include "DSVParallelReader.h"
+#include "DSVReader.h"
+#include "DSVScanner.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Non-owning source over part of a borrowed window
+class CSpanDataSource : public CDataSource {
+    private:
+        const char* DData;
+        size_t DLength;
+        size_t DIndex;
+    public:
+        CSpanDataSource(const char* data, size_t length) : DData(data), DLength(length), DIndex(0) {}
+
+        bool End() const noexcept override {
+            return DIndex >= DLength;
+        }
+
+        bool Get(char& ch) noexcept override {
+            if (DIndex < DLength) {
+                ch = DData[DIndex++];
+                return true;
+            }
+            return false;
+        }
+
+        bool Peek(char& ch) noexcept override {
+            if (DIndex < DLength) {
+                ch = DData[DIndex];
+                return true;
+            }
+            return false;
+        }
+
+        bool Read(std::vector<char>& buf, std::size_t count) noexcept override {
+            size_t length = std::min(count, DLength - DIndex);
+            buf.assign(DData + DIndex, DData + DIndex + length);
+            DIndex += length;
+            return !buf.empty();
+        }
+
+        bool Borrow(const char*& data, std::size_t& length) noexcept override {
+            data = DData + DIndex;
+            length = DLength - DIndex;
+            return length != 0;
+        }
+
+        bool Commit(std::size_t count) noexcept override {
+            if (count > DLength - DIndex) {
+                DIndex = DLength;
+                return false;
+            }
+            DIndex += count;
+            return true;
+        }
+};
+
+}
+
+struct CDSVParallelReader::SImplementation {
+    std::shared_ptr<CDataSource> DataSource;
+    char Delimiter;
+    size_t ChunkSize;
+    CWorkerPool Pool;
+    CDSVReader SequentialReader;
+    std::vector<std::vector<std::vector<std::string>>> ChunkRows;
+    size_t ChunkIndex;
+    size_t RowIndex;
+
+    SImplementation(std::shared_ptr<CDataSource> src, char delimiter, size_t threads, size_t chunksize)
+        : DataSource(src), Delimiter(delimiter == '"' ? ',' : delimiter), ChunkSize(std::max<size_t>(chunksize, 64)),
+          Pool(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          SequentialReader(src, delimiter), ChunkIndex(0), RowIndex(0) {}
+
+    static bool IsNewline(char character) {
+        return character == '\n' || character == '\r';
+    }
+
+    void SkipNewlines() {
+        const char* data;
+        size_t length;
+        while (DataSource->Borrow(data, length)) {
+            size_t index = 0;
+            while (index < length && IsNewline(data[index])) {
+                index++;
+            }
+            DataSource->Commit(index);
+            if (index < length) {
+                return;
+            }
+        }
+    }
+
+    // Finds the first or last newline outside quotes in [begin, end), or end
+    static size_t FindNewline(const char* data, size_t begin, size_t end, bool inquote, bool last) {
+        size_t found = end;
+        uint64_t quoteState = inquote ? ~uint64_t(0) : 0;
+        size_t index = begin;
+        for (; index + 64 <= end; index += 64) {
+            uint64_t mask = DSVScanner::StructuralMask(data + index, '\n', quoteState);
+            if (mask) {
+                if (!last) {
+                    return index + __builtin_ctzll(mask);
+                }
+                found = index + 63 - __builtin_clzll(mask);
+            }
+        }
+        bool insideQuotes = quoteState != 0;
+        for (; index < end; index++) {
+            if (data[index] == '"') {
+                insideQuotes = !insideQuotes;
+            } else if (!insideQuotes && IsNewline(data[index])) {
+                if (!last) {
+                    return index;
+                }
+                found = index;
+            }
+        }
+        return found;
+    }
+
+    // Parses all complete rows of the window that fit in one batch. Returns
+    // false if the batch holds no complete row.
+    bool ParseBatch(const char* data, size_t length) {
+        size_t region = std::min(length, ChunkSize * Pool.Size());
+        size_t chunks = (region + ChunkSize - 1) / ChunkSize;
+        std::vector<size_t> quotes(chunks);
+        std::vector<size_t> starts(chunks + 1);
+        std::vector<bool> inquote(chunks);
+
+        // Pass one counts quotes so every chunk knows its starting quote state
+        Pool.Run(chunks, [&](size_t chunk) {
+            size_t begin = chunk * ChunkSize;
+            quotes[chunk] = DSVScanner::CountQuotes(data + begin, std::min(begin + ChunkSize, region) - begin);
+        });
+        bool parity = false;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            inquote[chunk] = parity;
+            parity ^= quotes[chunk] & 1;
+        }
+
+        // The batch ends after the last newline outside quotes
+        size_t last = region;
+        for (size_t chunk = chunks; chunk-- > 0;) {
+            size_t begin = chunk * ChunkSize;
+            size_t end = std::min(begin + ChunkSize, region);
+            size_t found = FindNewline(data, begin, end, inquote[chunk], true);
+            if (found != end) {
+                last = found;
+                break;
+            }
+        }
+        if (last == region) {
+            return false;
+        }
+        size_t batchEnd = last + 1;
+
+        // Pass two finds where the first row of each chunk starts
+        starts[0] = 0;
+        starts[chunks] = batchEnd;
+        Pool.Run(chunks - 1, [&](size_t index) {
+            size_t chunk = index + 1;
+            size_t begin = chunk * ChunkSize;
+            size_t end = std::min(begin + ChunkSize, batchEnd);
+            size_t start = batchEnd;
+            if (begin < end) {
+                start = FindNewline(data, begin, end, inquote[chunk], false);
+                if (start == end) {
+                    start = batchEnd;
+                }
+            }
+            while (start < batchEnd && IsNewline(data[start])) {
+                start++;
+            }
+            starts[chunk] = start;
+        });
+        // Chunks without a row start hand their rows to the previous chunk
+        for (size_t chunk = chunks; chunk-- > 1;) {
+            starts[chunk] = std::min(starts[chunk], starts[chunk + 1]);
+        }
+
+        // Pass three parses the rows that start in each chunk
+        ChunkRows.resize(chunks);
+        Pool.Run(chunks, [&](size_t chunk) {
+            auto& rows = ChunkRows[chunk];
+            rows.clear();
+            auto source = std::make_shared<CSpanDataSource>(data + starts[chunk], starts[chunk + 1] - starts[chunk]);
+            CDSVReader reader(source, Delimiter);
+            std::vector<std::string> row;
+            while (reader.ReadRow(row)) {
+                rows.push_back(std::move(row));
+            }
+        });
+        ChunkIndex = 0;
+        RowIndex = 0;
+        // Rows are copies, so the blank lines after the batch can be consumed
+        // now and End() only has to look at the source
+        DataSource->Commit(batchEnd);
+        SkipNewlines();
+        return true;
+    }
+
+    bool HasParsedRows() const {
+        for (size_t chunk = ChunkIndex; chunk < ChunkRows.size(); chunk++) {
+            if (ChunkRows[chunk].size() > (chunk == ChunkIndex ? RowIndex : 0)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool NextParsedRow(std::vector<std::string>& row) {
+        while (ChunkIndex < ChunkRows.size()) {
+            auto& rows = ChunkRows[ChunkIndex];
+            if (RowIndex < rows.size()) {
+                row.swap(rows[RowIndex++]);
+                return true;
+            }
+            rows.clear();
+            ChunkIndex++;
+            RowIndex = 0;
+        }
+        return false;
+    }
+};
+
+CDSVParallelReader::CDSVParallelReader(std::shared_ptr<CDataSource> src, char delimiter, std::size_t threads, std::size_t chunksize)
+    : DImplementation(std::make_unique<SImplementation>(src, delimiter, threads, chunksize)) {}
+
+CDSVParallelReader::~CDSVParallelReader() = default;
+
+bool CDSVParallelReader::End() const {
+    return !DImplementation->HasParsedRows() && DImplementation->DataSource->End();
+}
+
+bool CDSVParallelReader::ReadRow(std::vector<std::string>& row) {
+    if (DImplementation->NextParsedRow(row)) {
+        return true;
+    }
+
+    const char* data;
+    size_t length;
+    if (DImplementation->DataSource->Borrow(data, length)
+        && DImplementation->ParseBatch(data, length)
+        && DImplementation->NextParsedRow(row)) {
+        return true;
+    }
+    // Rows that do not end inside the window are read sequentially
+    return DImplementation->SequentialReader.ReadRow(row);
+}
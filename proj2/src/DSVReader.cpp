@@ -1,51 +1,225 @@
 #include "DSVReader.h"
-#include <sstream>
+#include "DSVConvert.h"
+#include "DSVScanner.h"
 
 struct CDSVReader::SImplementation {
+    enum class ETerminator {Delimiter, Newline, End};
+
+    // Field of a view row, either in the source window or at an offset in Scratch
+    struct SFieldSpan {
+        const char* Data;
+        size_t Offset;
+        size_t Length;
+    };
+
     std::shared_ptr<CDataSource> DataSource;
     char Delimiter;
+    std::vector<SFieldSpan> Spans;
+    std::string Scratch;
+    std::vector<std::string> FallbackRow;
+    std::vector<std::string_view> ViewRow;
+    size_t PendingCommit;
+    SIOStatsCollector Stats;
     
     SImplementation(std::shared_ptr<CDataSource> src, char delimiter) 
-        : DataSource(src), Delimiter(delimiter == '"' ? ',' : delimiter) {}
+        : DataSource(src), Delimiter(delimiter == '"' ? ',' : delimiter), PendingCommit(0) {
+        IOSTATS_ONLY(DataSource = std::make_shared<CIOStatsDataSource>(DataSource, Stats.DStats));
+    }
     
-    bool ExtractField(std::string& value) {
-        value.clear();
-        char character;
-        bool insideQuotes = false;
-        
-        while (DataSource->Peek(character) && (character == ' ' || character == '\t')) {
-            DataSource->Get(character);
+    static bool IsNewline(char character) {
+        return character == '\n' || character == '\r';
+    }
+    
+    void SkipNewlines() {
+        const char* data;
+        size_t length;
+        while (DataSource->Borrow(data, length)) {
+            size_t index = 0;
+            while (index < length && IsNewline(data[index])) {
+                index++;
+            }
+            DataSource->Commit(index);
+            if (index < length) {
+                return;
+            }
         }
+    }
+    
+    // View rows leave their window borrowed until the next read. They are
+    // only returned when more data follows the row inside the window.
+    void CommitPending() {
+        if (PendingCommit) {
+            DataSource->Commit(PendingCommit);
+            PendingCommit = 0;
+        }
+    }
+    
+    // Scans a whole row held in the window into Spans without consuming it.
+    // Returns false if the row does not end inside the window.
+    bool ScanRow(const char* data, size_t length, size_t& consumed) {
+        Spans.clear();
+        Scratch.clear();
+        size_t index = 0;
         
-        if (DataSource->Peek(character) && character == '"') {
-            insideQuotes = true;
-            DataSource->Get(character);
+        while (true) {
+            while (index < length && (data[index] == ' ' || data[index] == '\t')) {
+                index++;
+            }
+            size_t start = index;
+            size_t next = index + DSVScanner::FindSpecial(data + index, length - index, Delimiter);
+            if (next == length) {
+                return false;
+            }
+            SFieldSpan span = {data + start, 0, next - start};
+            
+            if (data[next] == '"') {
+                size_t close = next + 1 + DSVScanner::FindQuote(data + next + 1, length - next - 1);
+                if (close + 1 >= length) {
+                    return false;
+                }
+                if (next == start && (data[close + 1] == Delimiter || IsNewline(data[close + 1]))) {
+                    span = {data + start + 1, 0, close - start - 1};
+                    next = close + 1;
+                } else {
+                    // Escaped or partially quoted fields are unescaped into Scratch
+                    span = {nullptr, Scratch.size(), 0};
+                    Scratch.append(data + start, next - start);
+                    bool insideQuotes = true;
+                    index = next + 1;
+                    while (true) {
+                        if (insideQuotes) {
+                            next = index + DSVScanner::FindQuote(data + index, length - index);
+                            if (next + 1 >= length) {
+                                return false;
+                            }
+                            Scratch.append(data + index, next - index);
+                            if (data[next + 1] == '"') {
+                                Scratch += '"';
+                                index = next + 2;
+                            } else {
+                                insideQuotes = false;
+                                index = next + 1;
+                            }
+                        } else {
+                            next = index + DSVScanner::FindSpecial(data + index, length - index, Delimiter);
+                            if (next == length) {
+                                return false;
+                            }
+                            Scratch.append(data + index, next - index);
+                            if (data[next] != '"') {
+                                break;
+                            }
+                            insideQuotes = true;
+                            index = next + 1;
+                        }
+                    }
+                    span.Length = Scratch.size() - span.Offset;
+                }
+            }
+            Spans.push_back(span);
+            
+            index = next + 1;
+            if (data[next] != Delimiter) {
+                while (index < length && IsNewline(data[index])) {
+                    index++;
+                }
+                consumed = index;
+                return true;
+            }
         }
+    }
+    
+    static void AppendColumnValue(SDSVColumn& column, const std::string_view* field) {
+        bool valid = field != nullptr;
+        switch (column.DType) {
+            case SDSVColumn::EType::String:
+                if (valid) {
+                    column.DArena.append(field->data(), field->size());
+                }
+                column.DOffsets.push_back(column.DArena.size());
+                break;
+            case SDSVColumn::EType::Int64: {
+                int64_t value = 0;
+                valid = valid && DSVConvert::ParseInt64(*field, value) == DSVConvert::EResult::Ok;
+                column.DInt64Values.push_back(valid ? value : 0);
+                break;
+            }
+            case SDSVColumn::EType::Double: {
+                double value = 0.0;
+                valid = valid && DSVConvert::ParseDouble(*field, value) == DSVConvert::EResult::Ok;
+                column.DDoubleValues.push_back(valid ? value : 0.0);
+                break;
+            }
+        }
+        column.DValid.push_back(valid);
+    }
+    
+    // Extracts one field and consumes its terminator. Runs of plain characters
+    // are located with the vectorized scanner and appended as whole slices.
+    ETerminator ExtractField(std::string& value) {
+        value.clear();
+        bool leading = true;
+        bool insideQuotes = false;
+        bool closingQuote = false;
+        const char* data;
+        size_t length;
         
-        while (DataSource->Get(character)) {
-            if (insideQuotes) {
-                if (character == '"') {
-                    if (DataSource->Peek(character) && character == '"') {
-                        DataSource->Get(character);
-                        value += character;
+        while (DataSource->Borrow(data, length)) {
+            size_t index = 0;
+            
+            // A quote ended the previous window, it may be the first half of ""
+            if (closingQuote) {
+                closingQuote = false;
+                if (data[0] == '"') {
+                    value += '"';
+                    insideQuotes = true;
+                    index = 1;
+                }
+            }
+            
+            if (leading) {
+                while (index < length && (data[index] == ' ' || data[index] == '\t')) {
+                    index++;
+                }
+                leading = index == length;
+            }
+            
+            while (index < length) {
+                if (insideQuotes) {
+                    size_t next = index + DSVScanner::FindQuote(data + index, length - index);
+                    value.append(data + index, next - index);
+                    if (next == length) {
+                        index = length;
+                    } else if (next + 1 == length) {
+                        insideQuotes = false;
+                        closingQuote = true;
+                        index = length;
+                    } else if (data[next + 1] == '"') {
+                        value += '"';
+                        index = next + 2;
                     } else {
                         insideQuotes = false;
+                        index = next + 1;
                     }
                 } else {
-                    value += character;
-                }
-            } else {
-                if (character == Delimiter || character == '\n' || character == '\r') {
-                    return true;
-                } else if (character == '"') {
-                    insideQuotes = true;
-                } else {
-                    value += character;
+                    size_t next = index + DSVScanner::FindSpecial(data + index, length - index, Delimiter);
+                    value.append(data + index, next - index);
+                    if (next == length) {
+                        index = length;
+                    } else if (data[next] == '"') {
+                        insideQuotes = true;
+                        index = next + 1;
+                    } else {
+                        // The window is invalid once committed
+                        ETerminator terminator = data[next] == Delimiter ? ETerminator::Delimiter : ETerminator::Newline;
+                        DataSource->Commit(next + 1);
+                        return terminator;
+                    }
                 }
             }
+            DataSource->Commit(index);
         }
-        
-        return !value.empty() || !DataSource->End();
+        return ETerminator::End;
     }
 };
 
@@ -55,40 +229,110 @@ CDSVReader::CDSVReader(std::shared_ptr<CDataSource> src, char delimiter)
 CDSVReader::~CDSVReader() = default;
 
 bool CDSVReader::End() const {
-    return DImplementation->DataSource->End();
+    IOSTATS_SCOPE(DImplementation->Stats);
+    // A borrowed view row is always followed by another row
+    return !DImplementation->PendingCommit && DImplementation->DataSource->End();
 }
 
 bool CDSVReader::ReadRow(std::vector<std::string>& row) {
-    row.clear();
     char character;
-    std::string value;
     
-    if (DImplementation->DataSource->Peek(character) && (character == '\n' || character == '\r')) {
-        while (DImplementation->DataSource->Peek(character) && (character == '\n' || character == '\r')) {
-            DImplementation->DataSource->Get(character);
-        }
+    IOSTATS_SCOPE(DImplementation->Stats);
+    DImplementation->CommitPending();
+    
+    if (!DImplementation->DataSource->Peek(character)) {
+        row.clear();
+        return false;
+    }
+    
+    IOSTATS_ONLY(DImplementation->Stats.DStats.DRecords++);
+    if (SImplementation::IsNewline(character)) {
+        row.clear();
+        DImplementation->SkipNewlines();
         return true;
     }
     
+    // Fields already in the row are reused so their storage is recycled
+    size_t count = 0;
+    SImplementation::ETerminator terminator;
     do {
-        if (!DImplementation->ExtractField(value)) {
-            return !row.empty();
+        if (count == row.size()) {
+            IOSTATS_TRACK_GROWTH(DImplementation->Stats, row, row.emplace_back());
         }
-        row.push_back(value);
-        
-        if (!DImplementation->DataSource->Peek(character)) {
-            break;
+        IOSTATS_TRACK_GROWTH(DImplementation->Stats, row[count], terminator = DImplementation->ExtractField(row[count]));
+        count++;
+    } while (terminator == SImplementation::ETerminator::Delimiter);
+    row.resize(count);
+    
+    if (terminator == SImplementation::ETerminator::Newline) {
+        DImplementation->SkipNewlines();
+    }
+    return true;
+}
+
+bool CDSVReader::ReadRowView(std::vector<std::string_view>& row) {
+    const char* data;
+    size_t length;
+    size_t consumed;
+    bool scanned;
+    
+    IOSTATS_SCOPE(DImplementation->Stats);
+    DImplementation->CommitPending();
+    row.clear();
+    if (!DImplementation->DataSource->Borrow(data, length)) {
+        return false;
+    }
+    
+    IOSTATS_TRACK_GROWTH(DImplementation->Stats, DImplementation->Scratch,
+        scanned = !SImplementation::IsNewline(data[0]) && DImplementation->ScanRow(data, length, consumed));
+    // A row that ends with the window may be the last one, or be followed by
+    // more newlines, so it is copied and End() never has to consume
+    if (scanned && consumed < length) {
+        IOSTATS_ONLY(DImplementation->Stats.DStats.DRecords++);
+        for (auto& span : DImplementation->Spans) {
+            const char* base = span.Data ? span.Data : DImplementation->Scratch.data() + span.Offset;
+            row.emplace_back(base, span.Length);
         }
-        if (character == '\n' || character == '\r') {
-            while (DImplementation->DataSource->Peek(character) && (character == '\n' || character == '\r')) {
-                DImplementation->DataSource->Get(character);
+        DImplementation->PendingCommit = consumed;
+        return true;
+    }
+    
+    // Rows that start with a newline or reach the end of the window take the
+    // copying path
+    if (!ReadRow(DImplementation->FallbackRow)) {
+        return false;
+    }
+    for (auto& field : DImplementation->FallbackRow) {
+        row.emplace_back(field);
+    }
+    return true;
+}
+
+std::size_t CDSVReader::ReadBatch(SDSVColumnBatch& batch, std::size_t maxrows) {
+    auto& row = DImplementation->ViewRow;
+    auto& columns = batch.DColumns;
+    
+    IOSTATS_SCOPE(DImplementation->Stats);
+    batch.Clear();
+    while (batch.DRowCount < maxrows && ReadRowView(row)) {
+        if (row.size() > columns.size()) {
+            // New columns start with empty values for the rows already read
+            size_t first = columns.size();
+            columns.resize(row.size());
+            for (size_t index = first; index < columns.size(); index++) {
+                columns[index].Clear();
+                columns[index].DOffsets.resize(batch.DRowCount + 1, 0);
+                columns[index].DValid.resize(batch.DRowCount, 0);
             }
-            break;
         }
-        if (character == DImplementation->Delimiter) {
-            DImplementation->DataSource->Get(character);
+        for (size_t index = 0; index < columns.size(); index++) {
+            SImplementation::AppendColumnValue(columns[index], index < row.size() ? &row[index] : nullptr);
         }
-    } while (true);
-    
-    return true;
+        batch.DRowCount++;
+    }
+    return batch.DRowCount;
+}
+
+SIOStats CDSVReader::Stats() const {
+    return DImplementation->Stats.Snapshot();
 }
@@ -0,0 +1,242 @@
+#include "DSVScanner.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DSVSCANNER_X86
+#include <immintrin.h>
+#endif
+
+namespace DSVScanner{
+
+namespace{
+
+struct SDispatch{
+    std::size_t (*FindSpecial)(const char *, std::size_t, char);
+    std::size_t (*FindQuote)(const char *, std::size_t);
+    void (*ClassifyBlock)(const char *, char, uint64_t &, uint64_t &);
+    const char *Name;
+};
+
+inline bool IsSpecial(char ch, char delimiter){
+    return (ch == delimiter) || (ch == '"') || (ch == '\n') || (ch == '\r');
+}
+
+std::size_t ScalarFindSpecial(const char *data, std::size_t length, char delimiter){
+    for(std::size_t Index = 0; Index < length; Index++){
+        if(IsSpecial(data[Index], delimiter)){
+            return Index;
+        }
+    }
+    return length;
+}
+
+std::size_t ScalarFindQuote(const char *data, std::size_t length){
+    const void *Found = std::memchr(data, '"', length);
+    return Found ? static_cast<const char *>(Found) - data : length;
+}
+
+void ScalarClassifyBlock(const char *block, char delimiter, uint64_t &quotes, uint64_t &separators){
+    quotes = 0;
+    separators = 0;
+    for(int Index = 0; Index < 64; Index++){
+        char Character = block[Index];
+        if(Character == '"'){
+            quotes |= uint64_t(1) << Index;
+        }
+        else if((Character == delimiter) || (Character == '\n') || (Character == '\r')){
+            separators |= uint64_t(1) << Index;
+        }
+    }
+}
+
+#ifdef DSVSCANNER_X86
+
+__attribute__((target("sse2")))
+inline uint32_t SSE2SpecialMask(const char *data, __m128i delimiter){
+    __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    __m128i Matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Block, delimiter), _mm_cmpeq_epi8(Block, _mm_set1_epi8('"'))),
+        _mm_or_si128(_mm_cmpeq_epi8(Block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(Block, _mm_set1_epi8('\r'))));
+    return _mm_movemask_epi8(Matches);
+}
+
+__attribute__((target("sse2")))
+std::size_t SSE2FindSpecial(const char *data, std::size_t length, char delimiter){
+    __m128i Delimiter = _mm_set1_epi8(delimiter);
+    std::size_t Index = 0;
+    for(; Index + 16 <= length; Index += 16){
+        uint32_t Mask = SSE2SpecialMask(data + Index, Delimiter);
+        if(Mask){
+            return Index + __builtin_ctz(Mask);
+        }
+    }
+    return Index + ScalarFindSpecial(data + Index, length - Index, delimiter);
+}
+
+__attribute__((target("sse2")))
+void SSE2ClassifyBlock(const char *block, char delimiter, uint64_t &quotes, uint64_t &separators){
+    __m128i Delimiter = _mm_set1_epi8(delimiter);
+    __m128i Quote = _mm_set1_epi8('"');
+    __m128i LineFeed = _mm_set1_epi8('\n');
+    __m128i CarriageReturn = _mm_set1_epi8('\r');
+    quotes = 0;
+    separators = 0;
+    for(int Offset = 0; Offset < 64; Offset += 16){
+        __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + Offset));
+        __m128i Separators = _mm_or_si128(_mm_cmpeq_epi8(Block, Delimiter),
+            _mm_or_si128(_mm_cmpeq_epi8(Block, LineFeed), _mm_cmpeq_epi8(Block, CarriageReturn)));
+        quotes |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(Block, Quote)))) << Offset;
+        separators |= uint64_t(uint32_t(_mm_movemask_epi8(Separators))) << Offset;
+    }
+}
+
+// The AVX2 kernels clear the upper register halves before returning or
+// falling back to other code, which may use legacy SSE encodings and would
+// otherwise stall on the transition. Tails shorter than a register are
+// handled with 128 bit VEX operations and scalar code.
+__attribute__((target("avx2")))
+std::size_t AVX2FindSpecial(const char *data, std::size_t length, char delimiter){
+    __m256i Delimiter = _mm256_set1_epi8(delimiter);
+    __m256i Quote = _mm256_set1_epi8('"');
+    __m256i LineFeed = _mm256_set1_epi8('\n');
+    __m256i CarriageReturn = _mm256_set1_epi8('\r');
+    std::size_t Index = 0;
+    uint32_t Mask = 0;
+    for(; Index + 32 <= length; Index += 32){
+        __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + Index));
+        __m256i Matches = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(Block, Delimiter), _mm256_cmpeq_epi8(Block, Quote)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(Block, LineFeed), _mm256_cmpeq_epi8(Block, CarriageReturn)));
+        Mask = _mm256_movemask_epi8(Matches);
+        if(Mask){
+            break;
+        }
+    }
+    if(!Mask && (Index + 16 <= length)){
+        __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + Index));
+        __m128i Matches = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(Block, _mm256_castsi256_si128(Delimiter)), _mm_cmpeq_epi8(Block, _mm256_castsi256_si128(Quote))),
+            _mm_or_si128(_mm_cmpeq_epi8(Block, _mm256_castsi256_si128(LineFeed)), _mm_cmpeq_epi8(Block, _mm256_castsi256_si128(CarriageReturn))));
+        Mask = _mm_movemask_epi8(Matches);
+        if(!Mask){
+            Index += 16;
+        }
+    }
+    _mm256_zeroupper();
+    if(Mask){
+        return Index + __builtin_ctz(Mask);
+    }
+    return Index + ScalarFindSpecial(data + Index, length - Index, delimiter);
+}
+
+__attribute__((target("avx2")))
+std::size_t AVX2FindQuote(const char *data, std::size_t length){
+    __m256i Quote = _mm256_set1_epi8('"');
+    std::size_t Index = 0;
+    uint32_t Mask = 0;
+    for(; Index + 32 <= length; Index += 32){
+        __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + Index));
+        Mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(Block, Quote));
+        if(Mask){
+            break;
+        }
+    }
+    _mm256_zeroupper();
+    if(Mask){
+        return Index + __builtin_ctz(Mask);
+    }
+    return Index + ScalarFindQuote(data + Index, length - Index);
+}
+
+__attribute__((target("avx2")))
+void AVX2ClassifyBlock(const char *block, char delimiter, uint64_t &quotes, uint64_t &separators){
+    __m256i Delimiter = _mm256_set1_epi8(delimiter);
+    __m256i Quote = _mm256_set1_epi8('"');
+    __m256i LineFeed = _mm256_set1_epi8('\n');
+    __m256i CarriageReturn = _mm256_set1_epi8('\r');
+    __m256i Low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    __m256i High = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+    quotes = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Low, Quote))))
+        | (uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(High, Quote)))) << 32);
+    __m256i LowSeparators = _mm256_or_si256(_mm256_cmpeq_epi8(Low, Delimiter),
+        _mm256_or_si256(_mm256_cmpeq_epi8(Low, LineFeed), _mm256_cmpeq_epi8(Low, CarriageReturn)));
+    __m256i HighSeparators = _mm256_or_si256(_mm256_cmpeq_epi8(High, Delimiter),
+        _mm256_or_si256(_mm256_cmpeq_epi8(High, LineFeed), _mm256_cmpeq_epi8(High, CarriageReturn)));
+    separators = uint64_t(uint32_t(_mm256_movemask_epi8(LowSeparators)))
+        | (uint64_t(uint32_t(_mm256_movemask_epi8(HighSeparators))) << 32);
+    _mm256_zeroupper();
+}
+
+#endif
+
+SDispatch SelectDispatch(){
+#ifdef DSVSCANNER_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        return {AVX2FindSpecial, AVX2FindQuote, AVX2ClassifyBlock, "avx2"};
+    }
+    if(__builtin_cpu_supports("sse2")){
+        return {SSE2FindSpecial, ScalarFindQuote, SSE2ClassifyBlock, "sse2"};
+    }
+#endif
+    return {ScalarFindSpecial, ScalarFindQuote, ScalarClassifyBlock, "scalar"};
+}
+
+const SDispatch &Dispatch(){
+    static const SDispatch Selected = SelectDispatch();
+    return Selected;
+}
+
+// Each set bit toggles the quote state, so the running xor of the quote mask
+// marks every position that is inside quotes
+inline uint64_t PrefixXor(uint64_t mask){
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+}
+
+std::size_t FindSpecial(const char *data, std::size_t length, char delimiter) noexcept{
+    return Dispatch().FindSpecial(data, length, delimiter);
+}
+
+std::size_t FindQuote(const char *data, std::size_t length) noexcept{
+    return Dispatch().FindQuote(data, length);
+}
+
+std::size_t CountQuotes(const char *data, std::size_t length) noexcept{
+    std::size_t Count = 0;
+    std::size_t Index = 0;
+    uint64_t Quotes, Separators;
+    for(; Index + 64 <= length; Index += 64){
+        Dispatch().ClassifyBlock(data + Index, '"', Quotes, Separators);
+        Count += __builtin_popcountll(Quotes);
+    }
+    for(; Index < length; Index++){
+        Count += data[Index] == '"';
+    }
+    return Count;
+}
+
+void ClassifyBlock(const char *block, char delimiter, uint64_t &quotes, uint64_t &separators) noexcept{
+    Dispatch().ClassifyBlock(block, delimiter, quotes, separators);
+}
+
+uint64_t StructuralMask(const char *block, char delimiter, uint64_t &inquote) noexcept{
+    uint64_t Quotes, Separators;
+    Dispatch().ClassifyBlock(block, delimiter, Quotes, Separators);
+    uint64_t Inside = PrefixXor(Quotes) ^ inquote;
+    inquote = uint64_t(int64_t(Inside) >> 63);
+    return Separators & ~Inside;
+}
+
+const char *Implementation() noexcept{
+    return Dispatch().Name;
+}
+
+}
@@ -0,0 +1,72 @@
+#include "DSVTypedReader.h"
+#include "DSVReader.h"
+
+struct CDSVTypedReader::SImplementation {
+    CDSVReader Reader;
+    std::vector<SDSVTypedField::EType> Schema;
+    std::vector<std::string_view> Fields;
+    size_t ErrorCount;
+    
+    SImplementation(std::shared_ptr<CDataSource> src, char delimiter, const std::vector<SDSVTypedField::EType>& schema)
+        : Reader(src, delimiter), Schema(schema), ErrorCount(0) {}
+    
+    static DSVConvert::EResult Convert(SDSVTypedField& field) {
+        switch (field.DType) {
+            case SDSVTypedField::EType::Int:
+                return DSVConvert::ParseInt64(field.DString, field.DInt);
+            case SDSVTypedField::EType::Double:
+                return DSVConvert::ParseDouble(field.DString, field.DDouble);
+            case SDSVTypedField::EType::Bool:
+                return DSVConvert::ParseBool(field.DString, field.DBool);
+            case SDSVTypedField::EType::Date:
+                return DSVConvert::ParseDate(field.DString, field.DInt);
+            case SDSVTypedField::EType::String:
+                break;
+        }
+        return DSVConvert::EResult::Ok;
+    }
+};
+
+CDSVTypedReader::CDSVTypedReader(std::shared_ptr<CDataSource> src, char delimiter, const std::vector<SDSVTypedField::EType>& schema)
+    : DImplementation(std::make_unique<SImplementation>(src, delimiter, schema)) {}
+
+CDSVTypedReader::~CDSVTypedReader() = default;
+
+bool CDSVTypedReader::End() const {
+    return DImplementation->Reader.End();
+}
+
+bool CDSVTypedReader::ReadRow(std::vector<SDSVTypedField>& row) {
+    auto& fields = DImplementation->Fields;
+    auto& schema = DImplementation->Schema;
+    
+    DImplementation->ErrorCount = 0;
+    if (!DImplementation->Reader.ReadRowView(fields)) {
+        row.clear();
+        return false;
+    }
+    
+    row.resize(schema.size());
+    for (size_t index = 0; index < schema.size(); index++) {
+        auto& field = row[index];
+        field.DType = schema[index];
+        field.DInt = 0;
+        field.DDouble = 0.0;
+        field.DBool = false;
+        if (index < fields.size()) {
+            field.DString = fields[index];
+            field.DResult = SImplementation::Convert(field);
+        } else {
+            field.DString = std::string_view();
+            field.DResult = DSVConvert::EResult::Empty;
+        }
+        if (!field.Valid() && field.DType != SDSVTypedField::EType::String) {
+            DImplementation->ErrorCount++;
+        }
+    }
+    return true;
+}
+
+std::size_t CDSVTypedReader::ErrorCount() const {
+    return DImplementation->ErrorCount;
+}
@@ -1,49 +1,94 @@
 #include "DSVWriter.h"
-#include <sstream>
+#include "DSVScanner.h"
+#include "TextEscaper.h"
+#include <cstring>
+
+namespace {
+
+const CTextEscaper QuoteEscaper({{'"', "\"\""}});
+
+}
 
 struct CDSVWriter::SImplementation {
     std::shared_ptr<CDataSink> DataSink;
     char Delimiter;
     bool QuoteAll;
+    // Length of the clean prefix of each field, kept between the two passes
+    std::vector<size_t> CleanLengths;
+    SIOStatsCollector Stats;
     
     SImplementation(std::shared_ptr<CDataSink> sink, char delimiter, bool quoteall) 
-        : DataSink(sink), Delimiter(delimiter == '"' ? ',' : delimiter), QuoteAll(quoteall) {}
+        : DataSink(sink), Delimiter(delimiter == '"' ? ',' : delimiter), QuoteAll(quoteall) {
+        IOSTATS_ONLY(DataSink = std::make_shared<CIOStatsDataSink>(DataSink, Stats.DStats));
+    }
     
-    bool RequiresQuoting(const std::string& str) const {
-        if (QuoteAll) return true;
-        
-        for (char character : str) {
-            if (character == Delimiter || character == '"' || character == '\n' || character == '\r') {
-                return true;
-            }
+    // A single scan finds the first character that forces quoting, the text
+    // before it is known to be clean and is copied without escaping
+    size_t FieldLength(const std::string& field) {
+        size_t clean = DSVScanner::FindSpecial(field.data(), field.size(), Delimiter);
+        IOSTATS_TRACK_GROWTH(Stats, CleanLengths, CleanLengths.push_back(clean));
+        if (clean == field.size() && !QuoteAll) {
+            return field.size();
         }
-        return false;
+        return clean + QuoteEscaper.EscapedLength(std::string_view(field).substr(clean)) + 2;
     }
     
-    bool WriteEnclosedField(const std::string& field) {
-        if (!DataSink->Put('"')) return false;
-        
-        for (char character : field) {
-            if (character == '"') {
-                if (!DataSink->Put('"')) return false;
-                if (!DataSink->Put('"')) return false;
-            } else {
-                if (!DataSink->Put(character)) return false;
+    size_t RowLength(const std::vector<std::string>& row) {
+        size_t length = row.empty() ? 1 : row.size();
+        for (auto& field : row) {
+            length += FieldLength(field);
+        }
+        return length;
+    }
+    
+    char* FormatField(const std::string& field, size_t clean, char* output) {
+        bool quoted = clean != field.size() || QuoteAll;
+        if (quoted) {
+            *output++ = '"';
+        }
+        std::memcpy(output, field.data(), clean);
+        output += clean;
+        if (quoted) {
+            output += QuoteEscaper.Escape(std::string_view(field).substr(clean), output);
+            *output++ = '"';
+        }
+        return output;
+    }
+    
+    char* FormatRow(const std::vector<std::string>& row, const size_t*& clean, char* output) {
+        for (size_t index = 0; index < row.size(); ++index) {
+            if (index) {
+                *output++ = Delimiter;
             }
+            output = FormatField(row[index], *clean++, output);
         }
-        
-        return DataSink->Put('"');
+        *output++ = '\n';
+        return output;
     }
     
-    bool WriteSingleField(const std::string& field) {
-        if (RequiresQuoting(field)) {
-            return WriteEnclosedField(field);
+    // Sizes all rows first so they are formatted into a single reservation
+    bool WriteRows(const std::vector<std::string>* rows, size_t count) {
+        size_t length = 0;
+        IOSTATS_SCOPE(Stats);
+        IOSTATS_ONLY(Stats.DStats.DRecords += count);
+        CleanLengths.clear();
+        for (size_t index = 0; index < count; index++) {
+            length += RowLength(rows[index]);
+        }
+        if (!length) {
+            return true;
         }
         
-        for (char character : field) {
-            if (!DataSink->Put(character)) return false;
+        char* buffer = DataSink->Reserve(length);
+        if (!buffer) {
+            return false;
         }
-        return true;
+        char* output = buffer;
+        const size_t* clean = CleanLengths.data();
+        for (size_t index = 0; index < count; index++) {
+            output = FormatRow(rows[index], clean, output);
+        }
+        return DataSink->Commit(output - buffer);
     }
 };
 
@@ -53,21 +98,32 @@ CDSVWriter::CDSVWriter(std::shared_ptr<CDataSink> sink, char delimiter, bool quo
 CDSVWriter::~CDSVWriter() = default;
 
 bool CDSVWriter::WriteRow(const std::vector<std::string>& row) {
-    if (row.empty()) {
-        return DImplementation->DataSink->Put('\n');
+    return DImplementation->WriteRows(&row, 1);
+}
+
+bool CDSVWriter::WriteRows(const std::vector<std::vector<std::string>>& rows) {
+    return DImplementation->WriteRows(rows.data(), rows.size());
+}
+
+std::size_t CDSVWriter::FormatRows(const std::vector<std::vector<std::string>>& rows, std::string& buf) {
+    size_t length = 0;
+    IOSTATS_SCOPE(DImplementation->Stats);
+    IOSTATS_ONLY(DImplementation->Stats.DStats.DRecords += rows.size());
+    DImplementation->CleanLengths.clear();
+    for (auto& row : rows) {
+        length += DImplementation->RowLength(row);
     }
     
-    for (size_t index = 0; index < row.size(); ++index) {
-        if (!DImplementation->WriteSingleField(row[index])) {
-            return false;
-        }
-        
-        if (index < row.size() - 1) {
-            if (!DImplementation->DataSink->Put(DImplementation->Delimiter)) {
-                return false;
-            }
-        }
+    size_t offset = buf.size();
+    buf.resize(offset + length);
+    char* output = &buf[offset];
+    const size_t* clean = DImplementation->CleanLengths.data();
+    for (auto& row : rows) {
+        output = DImplementation->FormatRow(row, clean, output);
     }
-    
-    return DImplementation->DataSink->Put('\n');
+    return length;
+}
+
+SIOStats CDSVWriter::Stats() const {
+    return DImplementation->Stats.Snapshot();
 }
@@ -0,0 +1,151 @@
+#include "FileDataSink.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+CFileDataSink::CFileDataSink(const std::string &path, bool append, std::size_t buffersize)
+    : DFileDescriptor(open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0666)),
+      DOwnsDescriptor(true), DBuffer(std::max<std::size_t>(buffersize, 1)), DLength(0), DReserving(false), DError(false){
+
+}
+
+CFileDataSink::CFileDataSink(int fd, bool closefd, std::size_t buffersize)
+    : DFileDescriptor(fd), DOwnsDescriptor(closefd), DBuffer(std::max<std::size_t>(buffersize, 1)),
+      DLength(0), DReserving(false), DError(false){
+
+}
+
+CFileDataSink::~CFileDataSink(){
+    Close();
+}
+
+bool CFileDataSink::WriteBuffered(const char *data, std::size_t length) noexcept{
+    struct iovec Vectors[2];
+    int VectorCount = 0;
+    if(DLength){
+        Vectors[VectorCount].iov_base = DBuffer.data();
+        Vectors[VectorCount].iov_len = DLength;
+        VectorCount++;
+    }
+    if(length){
+        Vectors[VectorCount].iov_base = const_cast<char *>(data);
+        Vectors[VectorCount].iov_len = length;
+        VectorCount++;
+    }
+    DLength = 0;
+    // Reserved space in DBuffer is gone once the buffer is written
+    DropReservation();
+    struct iovec *Current = Vectors;
+    while(VectorCount){
+        ssize_t Result = writev(DFileDescriptor, Current, VectorCount);
+        if(0 > Result){
+            if(EINTR == errno){
+                continue;
+            }
+            DError = true;
+            return false;
+        }
+        std::size_t Written = Result;
+        while(VectorCount && (Written >= Current->iov_len)){
+            Written -= Current->iov_len;
+            Current++;
+            VectorCount--;
+        }
+        if(VectorCount){
+            Current->iov_base = static_cast<char *>(Current->iov_base) + Written;
+            Current->iov_len -= Written;
+        }
+    }
+    return true;
+}
+
+void CFileDataSink::DropReservation() noexcept{
+    DReserving = false;
+    std::vector<char>().swap(DOverflow);
+}
+
+bool CFileDataSink::IsOpen() const noexcept{
+    return 0 <= DFileDescriptor;
+}
+
+bool CFileDataSink::Flush() noexcept{
+    if(!IsOpen() || DError){
+        return false;
+    }
+    return WriteBuffered(nullptr, 0);
+}
+
+bool CFileDataSink::Close() noexcept{
+    if(!IsOpen()){
+        return false;
+    }
+    bool Result = Flush();
+    if(DOwnsDescriptor && (0 != close(DFileDescriptor))){
+        Result = false;
+    }
+    DFileDescriptor = -1;
+    return Result;
+}
+
+bool CFileDataSink::Put(const char &ch) noexcept{
+    if(!IsOpen() || DError){
+        return false;
+    }
+    DropReservation();
+    if(DLength == DBuffer.size() && !WriteBuffered(nullptr, 0)){
+        return false;
+    }
+    DBuffer[DLength++] = ch;
+    return true;
+}
+
+bool CFileDataSink::Write(const std::vector<char> &buf) noexcept{
+    if(!IsOpen() || DError){
+        return false;
+    }
+    DropReservation();
+    if(DLength + buf.size() <= DBuffer.size()){
+        std::memcpy(DBuffer.data() + DLength, buf.data(), buf.size());
+        DLength += buf.size();
+        return true;
+    }
+    return WriteBuffered(buf.data(), buf.size());
+}
+
+char *CFileDataSink::Reserve(std::size_t count) noexcept{
+    if(!IsOpen() || DError){
+        return nullptr;
+    }
+    DropReservation();
+    if(count > DBuffer.size()){
+        // Committed together with the buffered data in one writev() call
+        DOverflow.resize(count);
+        DReserving = true;
+        return DOverflow.data();
+    }
+    if((DLength + count > DBuffer.size()) && !WriteBuffered(nullptr, 0)){
+        return nullptr;
+    }
+    DReserving = true;
+    return DBuffer.data() + DLength;
+}
+
+bool CFileDataSink::Commit(std::size_t count) noexcept{
+    if(!IsOpen() || DError || !DReserving){
+        return false;
+    }
+    DReserving = false;
+    if(!DOverflow.empty()){
+        std::vector<char> Overflow;
+        Overflow.swap(DOverflow);
+        return (count <= Overflow.size()) && WriteBuffered(Overflow.data(), count);
+    }
+    if(DLength + count > DBuffer.size()){
+        return false;
+    }
+    DLength += count;
+    return true;
+}
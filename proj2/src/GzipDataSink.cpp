@@ -0,0 +1,192 @@
+#include "GzipDataSink.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <climits>
+#include <zlib.h>
+
+struct CGzipDataSink::SImplementation {
+    // 16 selects a gzip header and trailer
+    static constexpr int WindowBits = 15 + 16;
+    static constexpr size_t OutputChunkSize = 65536;
+    
+    std::shared_ptr<CDataSink> DataSink;
+    int Level;
+    size_t Threads;
+    size_t BlockSize;
+    z_stream Stream;
+    std::vector<char> Input;
+    std::vector< std::vector<char> > Members;
+    std::vector<char> Results;
+    CWorkerPool Pool;
+    size_t ReservedBase;
+    bool Reserving;
+    bool MemberWritten;
+    bool Closed;
+    bool Error;
+    
+    SImplementation(std::shared_ptr<CDataSink> sink, int level, size_t threads, size_t blocksize)
+        : DataSink(sink), Level(level), Threads(std::max<size_t>(threads, 1)), BlockSize(std::max<size_t>(blocksize, 1)),
+          Stream{}, Members(Threads), Pool(Threads), ReservedBase(0), Reserving(false), MemberWritten(false), Closed(false), Error(false) {
+        Input.reserve(Capacity());
+        if(Threads == 1 && deflateInit2(&Stream, Level, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            Error = true;
+        }
+    }
+    
+    ~SImplementation() {
+        Close();
+    }
+    
+    size_t Capacity() const {
+        return Threads * BlockSize;
+    }
+    
+    // Streams Input through the single deflate stream into the sink
+    bool Deflate(int flush) {
+        Stream.next_in = reinterpret_cast<Bytef *>(Input.data());
+        Stream.avail_in = Input.size();
+        int Result;
+        do {
+            char *Buffer = DataSink->Reserve(OutputChunkSize);
+            if(!Buffer) {
+                return false;
+            }
+            Stream.next_out = reinterpret_cast<Bytef *>(Buffer);
+            Stream.avail_out = OutputChunkSize;
+            Result = deflate(&Stream, flush);
+            if(Result == Z_STREAM_ERROR || !DataSink->Commit(OutputChunkSize - Stream.avail_out)) {
+                return false;
+            }
+        } while(!Stream.avail_out || (flush == Z_FINISH && Result != Z_STREAM_END));
+        Input.clear();
+        return true;
+    }
+    
+    static bool CompressMember(const char *data, size_t length, int level, std::vector<char> &member) {
+        z_stream MemberStream{};
+        if(deflateInit2(&MemberStream, level, Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        member.resize(deflateBound(&MemberStream, length));
+        MemberStream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        MemberStream.avail_in = length;
+        MemberStream.next_out = reinterpret_cast<Bytef *>(member.data());
+        MemberStream.avail_out = member.size();
+        bool Success = deflate(&MemberStream, Z_FINISH) == Z_STREAM_END;
+        member.resize(member.size() - MemberStream.avail_out);
+        deflateEnd(&MemberStream);
+        return Success;
+    }
+    
+    // Compresses each block of Input as its own member on the worker pool
+    bool DeflateMembers() {
+        // An empty stream still needs one member to be valid gzip
+        size_t BlockCount = std::max<size_t>((Input.size() + BlockSize - 1) / BlockSize, 1);
+        Members.resize(std::max(Members.size(), BlockCount));
+        Results.assign(BlockCount, 0);
+        Pool.Run(BlockCount, [this](size_t Block) {
+            size_t Offset = Block * BlockSize;
+            size_t Length = std::min(BlockSize, Input.size() - Offset);
+            Results[Block] = CompressMember(Input.data() + Offset, Length, Level, Members[Block]);
+        });
+        for(size_t Block = 0; Block < BlockCount; Block++) {
+            if(!Results[Block] || !DataSink->WriteBlock(Members[Block].data(), Members[Block].size())) {
+                return false;
+            }
+        }
+        Input.clear();
+        return true;
+    }
+    
+    // Space reserved but not committed is not part of the data
+    void DropReservation() {
+        if(Reserving) {
+            Input.resize(ReservedBase);
+            Reserving = false;
+        }
+    }
+    
+    bool Compress(bool finish) {
+        DropReservation();
+        if(Error || Closed) {
+            return false;
+        }
+        if(Threads == 1) {
+            Error = !Deflate(finish ? Z_FINISH : Z_NO_FLUSH);
+        } else if(!Input.empty() || (finish && !MemberWritten)) {
+            Error = !DeflateMembers();
+            MemberWritten = true;
+        }
+        return !Error;
+    }
+    
+    bool Append(const char *data, size_t length) {
+        DropReservation();
+        while(length) {
+            if(Input.size() == Capacity() && !Compress(false)) {
+                return false;
+            }
+            size_t Length = std::min(length, Capacity() - Input.size());
+            Input.insert(Input.end(), data, data + Length);
+            data += Length;
+            length -= Length;
+        }
+        return !Error && !Closed;
+    }
+    
+    bool Close() {
+        if(Closed) {
+            return !Error;
+        }
+        Compress(true);
+        Closed = true;
+        if(Threads == 1) {
+            deflateEnd(&Stream);
+        }
+        return !Error;
+    }
+};
+
+CGzipDataSink::CGzipDataSink(std::shared_ptr<CDataSink> sink, int level, std::size_t threads, std::size_t blocksize)
+    : DImplementation(std::make_unique<SImplementation>(sink, level, threads, blocksize)) {
+}
+
+CGzipDataSink::~CGzipDataSink() = default;
+
+bool CGzipDataSink::Close() noexcept {
+    return DImplementation->Close();
+}
+
+bool CGzipDataSink::Put(const char &ch) noexcept {
+    return DImplementation->Append(&ch, 1);
+}
+
+bool CGzipDataSink::Write(const std::vector<char> &buf) noexcept {
+    return DImplementation->Append(buf.data(), buf.size());
+}
+
+char *CGzipDataSink::Reserve(std::size_t count) noexcept {
+    DImplementation->DropReservation();
+    if(DImplementation->Closed) {
+        return nullptr;
+    }
+    if(DImplementation->Input.size() + count > DImplementation->Capacity() && !DImplementation->Compress(false)) {
+        return nullptr;
+    }
+    DImplementation->ReservedBase = DImplementation->Input.size();
+    DImplementation->Input.resize(DImplementation->ReservedBase + count);
+    DImplementation->Reserving = true;
+    return DImplementation->Input.data() + DImplementation->ReservedBase;
+}
+
+bool CGzipDataSink::Commit(std::size_t count) noexcept {
+    if(!DImplementation->Reserving || (DImplementation->ReservedBase + count > DImplementation->Input.size())) {
+        return false;
+    }
+    DImplementation->Input.resize(DImplementation->ReservedBase + count);
+    DImplementation->Reserving = false;
+    if(DImplementation->Input.size() >= DImplementation->Capacity()) {
+        return DImplementation->Compress(false);
+    }
+    return !DImplementation->Error;
+}
@@ -0,0 +1,144 @@
+#include "GzipDataSource.h"
+#include <algorithm>
+#include <climits>
+#include <zlib.h>
+
+struct CGzipDataSource::SImplementation {
+    std::shared_ptr<CDataSource> DataSource;
+    z_stream Stream;
+    std::vector<char> Output;
+    size_t OutputIndex;
+    size_t OutputLength;
+    bool StreamEnd;
+    bool Finished;
+    bool Error;
+    
+    SImplementation(std::shared_ptr<CDataSource> src, size_t buffersize)
+        : DataSource(src), Stream{}, Output(std::max<size_t>(buffersize, 1)), OutputIndex(0), OutputLength(0),
+          StreamEnd(false), Finished(false), Error(false) {
+        // 32 enables automatic detection of gzip and zlib headers
+        if(inflateInit2(&Stream, 15 + 32) != Z_OK) {
+            Error = Finished = true;
+        }
+        Fill();
+    }
+    
+    ~SImplementation() {
+        inflateEnd(&Stream);
+    }
+    
+    size_t Remaining() const {
+        return OutputLength - OutputIndex;
+    }
+    
+    // Inflates until some output is available or the input is exhausted
+    void Fill() {
+        OutputIndex = OutputLength = 0;
+        while(!Finished && !OutputLength) {
+            const char *Data;
+            size_t Length;
+            if(!DataSource->Borrow(Data, Length)) {
+                // Input that stops inside a member is truncated
+                Error = Error || !StreamEnd;
+                Finished = true;
+                break;
+            }
+            if(StreamEnd) {
+                // Zero padding after a member is skipped, as gzip does
+                size_t Zeros = 0;
+                while(Zeros < Length && !Data[Zeros]) {
+                    Zeros++;
+                }
+                if(Zeros) {
+                    DataSource->Commit(Zeros);
+                    continue;
+                }
+                inflateReset(&Stream);
+                StreamEnd = false;
+            }
+            Length = std::min<size_t>(Length, UINT_MAX);
+            Stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(Data));
+            Stream.avail_in = Length;
+            Stream.next_out = reinterpret_cast<Bytef *>(Output.data());
+            Stream.avail_out = Output.size();
+            int Result = inflate(&Stream, Z_NO_FLUSH);
+            DataSource->Commit(Length - Stream.avail_in);
+            OutputLength = Output.size() - Stream.avail_out;
+            if(Result == Z_STREAM_END) {
+                StreamEnd = true;
+            } else if(Result != Z_OK && Result != Z_BUF_ERROR) {
+                Error = Finished = true;
+            }
+        }
+    }
+    
+    void Advance(size_t count) {
+        OutputIndex += count;
+        if(!Remaining()) {
+            Fill();
+        }
+    }
+};
+
+CGzipDataSource::CGzipDataSource(std::shared_ptr<CDataSource> src, std::size_t buffersize)
+    : DImplementation(std::make_unique<SImplementation>(src, buffersize)) {
+}
+
+CGzipDataSource::~CGzipDataSource() = default;
+
+bool CGzipDataSource::HasError() const noexcept {
+    return DImplementation->Error;
+}
+
+bool CGzipDataSource::End() const noexcept {
+    return !DImplementation->Remaining();
+}
+
+bool CGzipDataSource::Get(char &ch) noexcept {
+    if(!DImplementation->Remaining()) {
+        return false;
+    }
+    ch = DImplementation->Output[DImplementation->OutputIndex];
+    DImplementation->Advance(1);
+    return true;
+}
+
+bool CGzipDataSource::Peek(char &ch) noexcept {
+    if(!DImplementation->Remaining()) {
+        return false;
+    }
+    ch = DImplementation->Output[DImplementation->OutputIndex];
+    return true;
+}
+
+bool CGzipDataSource::Read(std::vector<char> &buf, std::size_t count) noexcept {
+    buf.clear();
+    while(buf.size() < count && DImplementation->Remaining()) {
+        size_t Length = std::min(count - buf.size(), DImplementation->Remaining());
+        const char *Data = DImplementation->Output.data() + DImplementation->OutputIndex;
+        buf.insert(buf.end(), Data, Data + Length);
+        DImplementation->Advance(Length);
+    }
+    return !buf.empty();
+}
+
+bool CGzipDataSource::Borrow(const char *&data, std::size_t &length) noexcept {
+    length = DImplementation->Remaining();
+    if(!length) {
+        return false;
+    }
+    data = DImplementation->Output.data() + DImplementation->OutputIndex;
+    return true;
+}
+
+bool CGzipDataSource::Commit(std::size_t count) noexcept {
+    while(count) {
+        size_t Length = std::min(count, DImplementation->Remaining());
+        if(!Length) {
+            return false;
+        }
+        DImplementation->Advance(Length);
+        count -= Length;
+    }
+    return true;
+}
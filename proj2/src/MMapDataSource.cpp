@@ -0,0 +1,159 @@
+#include "MMapDataSource.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+CMMapDataSource::CMMapDataSource(const std::string &path, std::size_t buffersize)
+    : DFileDescriptor(open(path.c_str(), O_RDONLY | O_CLOEXEC)), DOwnsDescriptor(true), DMapped(nullptr),
+      DMappedLength(0), DBufferLength(0), DIndex(0), DEndOfFile(false){
+    Open(buffersize);
+}
+
+CMMapDataSource::CMMapDataSource(int fd, bool closefd, std::size_t buffersize)
+    : DFileDescriptor(fd), DOwnsDescriptor(closefd), DMapped(nullptr), DMappedLength(0),
+      DBufferLength(0), DIndex(0), DEndOfFile(false){
+    Open(buffersize);
+}
+
+CMMapDataSource::~CMMapDataSource(){
+    if(DMapped){
+        munmap(DMapped, DMappedLength);
+    }
+    if(DOwnsDescriptor && (0 <= DFileDescriptor)){
+        close(DFileDescriptor);
+    }
+}
+
+void CMMapDataSource::Open(std::size_t buffersize) noexcept{
+    if(0 > DFileDescriptor){
+        DEndOfFile = true;
+        return;
+    }
+    struct stat Status;
+    // Files like those in /proc report a size of zero but still have
+    // contents, so only files with a size are mapped
+    if((0 == fstat(DFileDescriptor, &Status)) && S_ISREG(Status.st_mode) && (0 < Status.st_size)){
+        off_t Offset = lseek(DFileDescriptor, 0, SEEK_CUR);
+        if(0 > Offset){
+            Offset = 0;
+        }
+        if(Status.st_size <= Offset){
+            DEndOfFile = true;
+            return;
+        }
+        // Offsets must be page aligned, so map from zero and skip ahead
+        void *Mapping = mmap(nullptr, Status.st_size, PROT_READ, MAP_PRIVATE, DFileDescriptor, 0);
+        if(MAP_FAILED != Mapping){
+            DMapped = static_cast<char *>(Mapping);
+            DMappedLength = Status.st_size;
+            DIndex = Offset;
+            DEndOfFile = true;
+            madvise(DMapped, DMappedLength, MADV_SEQUENTIAL);
+            return;
+        }
+    }
+    DBuffer.resize(std::max<std::size_t>(buffersize, 1));
+    Fill();
+}
+
+void CMMapDataSource::Fill() noexcept{
+    if(DMapped || DEndOfFile || (DIndex < DBufferLength)){
+        return;
+    }
+    DIndex = 0;
+    DBufferLength = 0;
+    while(true){
+        ssize_t Result = read(DFileDescriptor, DBuffer.data(), DBuffer.size());
+        if(0 < Result){
+            DBufferLength = Result;
+            return;
+        }
+        if((0 > Result) && (EINTR == errno)){
+            continue;
+        }
+        DEndOfFile = true;
+        return;
+    }
+}
+
+std::size_t CMMapDataSource::Remaining() const noexcept{
+    return (DMapped ? DMappedLength : DBufferLength) - DIndex;
+}
+
+const char *CMMapDataSource::Current() const noexcept{
+    return (DMapped ? DMapped : DBuffer.data()) + DIndex;
+}
+
+bool CMMapDataSource::IsOpen() const noexcept{
+    return 0 <= DFileDescriptor;
+}
+
+bool CMMapDataSource::IsMapped() const noexcept{
+    return DMapped != nullptr;
+}
+
+const char *CMMapDataSource::Data() const noexcept{
+    return DMapped;
+}
+
+std::size_t CMMapDataSource::Size() const noexcept{
+    return DMappedLength;
+}
+
+bool CMMapDataSource::End() const noexcept{
+    return !Remaining() && DEndOfFile;
+}
+
+bool CMMapDataSource::Get(char &ch) noexcept{
+    if(!Remaining()){
+        return false;
+    }
+    ch = *Current();
+    DIndex++;
+    Fill();
+    return true;
+}
+
+bool CMMapDataSource::Peek(char &ch) noexcept{
+    if(!Remaining()){
+        return false;
+    }
+    ch = *Current();
+    return true;
+}
+
+bool CMMapDataSource::Read(std::vector<char> &buf, std::size_t count) noexcept{
+    buf.clear();
+    while((buf.size() < count) && Remaining()){
+        std::size_t Length = std::min(count - buf.size(), Remaining());
+        buf.insert(buf.end(), Current(), Current() + Length);
+        DIndex += Length;
+        Fill();
+    }
+    return !buf.empty();
+}
+
+bool CMMapDataSource::Borrow(const char *&data, std::size_t &length) noexcept{
+    length = Remaining();
+    if(!length){
+        return false;
+    }
+    data = Current();
+    return true;
+}
+
+bool CMMapDataSource::Commit(std::size_t count) noexcept{
+    while(count){
+        std::size_t Length = std::min(count, Remaining());
+        if(!Length){
+            return false;
+        }
+        DIndex += Length;
+        count -= Length;
+        Fill();
+    }
+    return true;
+}
@@ -1,15 +1,47 @@
 #include "StringDataSink.h"
 
+CStringDataSink::CStringDataSink() : DReservedBase(0), DReserving(false){
+
+}
+
 const std::string &CStringDataSink::String() const{
     return DString;
 }
 
+// Space reserved but not committed is not part of the data
+void CStringDataSink::DropReservation() noexcept{
+    if(DReserving){
+        DString.resize(DReservedBase);
+        DReserving = false;
+    }
+}
+
 bool CStringDataSink::Put(const char &ch) noexcept{
-    DString += std::string(1,ch);
+    DropReservation();
+    DString.push_back(ch);
     return true;
 }
 
 bool CStringDataSink::Write(const std::vector<char> &buf) noexcept{
-    DString += std::string(buf.data(),buf.size());
+    DropReservation();
+    DString.append(buf.data(),buf.size());
+    return true;
+}
+
+char *CStringDataSink::Reserve(std::size_t count) noexcept{
+    // Reserved space lives past the end of the string until it is committed
+    DropReservation();
+    DReservedBase = DString.length();
+    DString.resize(DReservedBase + count);
+    DReserving = true;
+    return &DString[DReservedBase];
+}
+
+bool CStringDataSink::Commit(std::size_t count) noexcept{
+    if(!DReserving || (DReservedBase + count > DString.length())){
+        return false;
+    }
+    DString.resize(DReservedBase + count);
+    DReserving = false;
     return true;
 }
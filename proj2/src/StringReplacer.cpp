@@ -0,0 +1,134 @@
+#include "StringReplacer.h"
+#include <algorithm>
+
+CStringReplacer::CStringReplacer(std::initializer_list< std::pair< std::string_view, std::string_view > > replacements){
+    for(auto &Replacement : replacements){
+        DPatterns.emplace_back(Replacement.first);
+        DReplacements.emplace_back(Replacement.second);
+    }
+    Compile();
+}
+
+CStringReplacer::CStringReplacer(const std::vector< std::pair< std::string, std::string > > &replacements){
+    for(auto &Replacement : replacements){
+        DPatterns.push_back(Replacement.first);
+        DReplacements.push_back(Replacement.second);
+    }
+    Compile();
+}
+
+void CStringReplacer::Compile(){
+    // Builds the trie, zero marks a missing transition until the links are set
+    DTransitions.assign(256, 0);
+    DDepths.assign(1, 0);
+    DOutputs.assign(1, NoPattern);
+    std::fill(std::begin(DStarts), std::end(DStarts), false);
+    for(uint32_t Pattern = 0; Pattern < DPatterns.size(); Pattern++){
+        if(DPatterns[Pattern].empty()){
+            continue;
+        }
+        uint32_t State = 0;
+        for(unsigned char Character : DPatterns[Pattern]){
+            uint32_t &Next = DTransitions[State * 256 + Character];
+            if(!Next){
+                Next = DDepths.size();
+                DDepths.push_back(DDepths[State] + 1);
+                DOutputs.push_back(NoPattern);
+                DTransitions.resize(DTransitions.size() + 256, 0);
+            }
+            State = DTransitions[State * 256 + Character];
+        }
+        if(DOutputs[State] == NoPattern){
+            DOutputs[State] = Pattern;
+        }
+        DStarts[static_cast<unsigned char>(DPatterns[Pattern][0])] = true;
+    }
+
+    // Breadth first so each failure link points to a finished state, missing
+    // transitions are then filled from the failure state to make a full DFA
+    std::vector<uint32_t> Failures(DDepths.size(), 0);
+    std::vector<uint32_t> Queue;
+    for(int Character = 0; Character < 256; Character++){
+        if(DTransitions[Character]){
+            Queue.push_back(DTransitions[Character]);
+        }
+    }
+    for(std::size_t Index = 0; Index < Queue.size(); Index++){
+        uint32_t State = Queue[Index];
+        if(DOutputs[State] == NoPattern){
+            DOutputs[State] = DOutputs[Failures[State]];
+        }
+        for(int Character = 0; Character < 256; Character++){
+            uint32_t &Next = DTransitions[State * 256 + Character];
+            uint32_t Fallback = DTransitions[Failures[State] * 256 + Character];
+            if(Next){
+                Failures[Next] = Fallback;
+                Queue.push_back(Next);
+            }
+            else{
+                Next = Fallback;
+            }
+        }
+    }
+}
+
+std::size_t CStringReplacer::PatternCount() const noexcept{
+    return DPatterns.size();
+}
+
+std::string CStringReplacer::Replace(std::string_view text) const{
+    std::string Result;
+    Result.reserve(text.length());
+    Append(Result, text);
+    return Result;
+}
+
+void CStringReplacer::Append(std::string &str, std::string_view text) const{
+    std::size_t Length = text.length();
+    std::size_t Copied = 0;
+    std::size_t Index = 0;
+    uint32_t State = 0;
+    // Best match found so far, kept until no longer or earlier match can appear
+    uint32_t Best = NoPattern;
+    std::size_t BestStart = 0;
+    std::size_t BestEnd = 0;
+
+    while(true){
+        if(Index == Length){
+            if(Best == NoPattern){
+                break;
+            }
+        }
+        else{
+            if(!State && Best == NoPattern){
+                while(Index < Length && !DStarts[static_cast<unsigned char>(text[Index])]){
+                    Index++;
+                }
+                if(Index == Length){
+                    break;
+                }
+            }
+            State = DTransitions[State * 256 + static_cast<unsigned char>(text[Index])];
+            Index++;
+            uint32_t Output = DOutputs[State];
+            if(Output != NoPattern){
+                std::size_t Start = Index - DPatterns[Output].length();
+                if(Best == NoPattern || Start < BestStart || (Start == BestStart && Index > BestEnd)){
+                    Best = Output;
+                    BestStart = Start;
+                    BestEnd = Index;
+                }
+            }
+            if(Best == NoPattern || Index - DDepths[State] <= BestStart){
+                continue;
+            }
+        }
+        // Scanning restarts after the replaced match
+        str.append(text.substr(Copied, BestStart - Copied));
+        str.append(DReplacements[Best]);
+        Copied = Index = BestEnd;
+        State = 0;
+        Best = NoPattern;
+    }
+    str.append(text.substr(Copied));
+}
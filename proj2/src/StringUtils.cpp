@@ -1,130 +1,449 @@
 #include "StringUtils.h"
 #include <algorithm>
 #include <cctype>
-#include <sstream>
+#include <cstdint>
+#include <functional>
+#include <thread>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#define STRINGUTILS_X86
+#include <immintrin.h>
+#endif
+
 namespace StringUtils {
 
-std::string Substring(const std::string &text, ssize_t begin, ssize_t finish) noexcept {
-    if (finish == 0) finish = text.length();
-    if (begin < 0) begin += text.length();
-    if (finish < 0) finish += text.length();
-    if (begin > finish) return "";
+static const char *const Whitespace = " \t\n\v\f\r";
+
+// ASCII kernels for case conversion and whitespace skipping. Bytes outside
+// ASCII are never changed or treated as whitespace, which matches the
+// classic C locale behavior of toupper, tolower and isspace.
+namespace {
+
+using TConvertFunction = void (*)(const char *, char *, size_t, char);
+using TSkipFunction = size_t (*)(const char *, size_t);
+
+bool IsWhitespace(char character) {
+    return character == ' ' || static_cast<unsigned char>(character - '\t') < 5;
+}
+
+// Flips the case of letters in the 26 character range starting at first
+void ScalarConvert(const char *source, char *destination, size_t length, char first) {
+    for (size_t index = 0; index < length; index++) {
+        char character = source[index];
+        bool letter = static_cast<unsigned char>(character - first) < 26;
+        destination[index] = character ^ (letter ? 0x20 : 0);
+    }
+}
+
+size_t ScalarSkip(const char *data, size_t length) {
+    size_t index = 0;
+    while (index < length && IsWhitespace(data[index])) {
+        index++;
+    }
+    return index;
+}
+
+// Returns the length left once trailing whitespace is skipped
+size_t ScalarSkipBack(const char *data, size_t length) {
+    while (length && IsWhitespace(data[length - 1])) {
+        length--;
+    }
+    return length;
+}
+
+#ifdef STRINGUTILS_X86
+
+// Signed compares keep bytes above 0x7F out of both ranges
+__attribute__((target("sse2")))
+__m128i SSE2Whitespace(__m128i block) {
+    __m128i control = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1)));
+    return _mm_or_si128(control, _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')));
+}
+
+__attribute__((target("sse2")))
+void SSE2Convert(const char *source, char *destination, size_t length, char first) {
+    __m128i low = _mm_set1_epi8(first - 1);
+    __m128i high = _mm_set1_epi8(first + 26);
+    __m128i flip = _mm_set1_epi8(0x20);
+    size_t index = 0;
+    for (; index + 16 <= length; index += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + index));
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(block, low), _mm_cmplt_epi8(block, high));
+        block = _mm_xor_si128(block, _mm_and_si128(letters, flip));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), block);
+    }
+    ScalarConvert(source + index, destination + index, length - index, first);
+}
+
+__attribute__((target("sse2")))
+size_t SSE2Skip(const char *data, size_t length) {
+    size_t index = 0;
+    for (; index + 16 <= length; index += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index));
+        uint32_t mask = ~_mm_movemask_epi8(SSE2Whitespace(block)) & 0xFFFF;
+        if (mask) {
+            return index + __builtin_ctz(mask);
+        }
+    }
+    return index + ScalarSkip(data + index, length - index);
+}
+
+__attribute__((target("sse2")))
+size_t SSE2SkipBack(const char *data, size_t length) {
+    for (; length >= 16; length -= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + length - 16));
+        uint32_t mask = ~_mm_movemask_epi8(SSE2Whitespace(block)) & 0xFFFF;
+        if (mask) {
+            return length - 16 + 32 - __builtin_clz(mask);
+        }
+    }
+    return ScalarSkipBack(data, length);
+}
+
+__attribute__((target("avx2")))
+__m256i AVX2Whitespace(__m256i block) {
+    __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), block));
+    return _mm256_or_si256(control, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')));
+}
+
+// VEX encoded 128 bit version for the tails of the AVX2 kernels
+__attribute__((target("avx2")))
+__m128i AVX2Whitespace(__m128i block) {
+    __m128i control = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('\r' + 1), block));
+    return _mm_or_si128(control, _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')));
+}
+
+// The AVX2 kernels finish their tails with 128 bit VEX operations and scalar
+// code, and clear the upper register halves before leaving. Handing the tail
+// to the SSE2 kernels with dirty upper halves stalls on every short string.
+__attribute__((target("avx2")))
+void AVX2Convert(const char *source, char *destination, size_t length, char first) {
+    __m256i low = _mm256_set1_epi8(first - 1);
+    __m256i high = _mm256_set1_epi8(first + 26);
+    __m256i flip = _mm256_set1_epi8(0x20);
+    size_t index = 0;
+    for (; index + 32 <= length; index += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + index));
+        __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(block, low), _mm256_cmpgt_epi8(high, block));
+        block = _mm256_xor_si256(block, _mm256_and_si256(letters, flip));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index), block);
+    }
+    if (index + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + index));
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(block, _mm256_castsi256_si128(low)), _mm_cmpgt_epi8(_mm256_castsi256_si128(high), block));
+        block = _mm_xor_si128(block, _mm_and_si128(letters, _mm256_castsi256_si128(flip)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), block);
+        index += 16;
+    }
+    _mm256_zeroupper();
+    ScalarConvert(source + index, destination + index, length - index, first);
+}
+
+__attribute__((target("avx2")))
+size_t AVX2Skip(const char *data, size_t length) {
+    size_t index = 0;
+    uint32_t mask = 0;
+    for (; index + 32 <= length; index += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + index));
+        mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(AVX2Whitespace(block)));
+        if (mask) {
+            break;
+        }
+    }
+    if (!mask && index + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index));
+        mask = ~_mm_movemask_epi8(AVX2Whitespace(block)) & 0xFFFF;
+        if (!mask) {
+            index += 16;
+        }
+    }
+    _mm256_zeroupper();
+    if (mask) {
+        return index + __builtin_ctz(mask);
+    }
+    return index + ScalarSkip(data + index, length - index);
+}
+
+__attribute__((target("avx2")))
+size_t AVX2SkipBack(const char *data, size_t length) {
+    uint32_t mask = 0;
+    for (; length >= 32; length -= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + length - 32));
+        mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(AVX2Whitespace(block)));
+        if (mask) {
+            break;
+        }
+    }
+    if (mask) {
+        _mm256_zeroupper();
+        return length - __builtin_clz(mask);
+    }
+    if (length >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + length - 16));
+        mask = ~_mm_movemask_epi8(AVX2Whitespace(block)) & 0xFFFF;
+        if (mask) {
+            _mm256_zeroupper();
+            return length - 16 + 32 - __builtin_clz(mask);
+        }
+        length -= 16;
+    }
+    _mm256_zeroupper();
+    return ScalarSkipBack(data, length);
+}
+
+#endif
+
+struct SKernels {
+    TConvertFunction Convert;
+    TSkipFunction Skip;
+    TSkipFunction SkipBack;
+};
+
+SKernels SelectKernels() {
+#ifdef STRINGUTILS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {AVX2Convert, AVX2Skip, AVX2SkipBack};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {SSE2Convert, SSE2Skip, SSE2SkipBack};
+    }
+#endif
+    return {ScalarConvert, ScalarSkip, ScalarSkipBack};
+}
+
+const SKernels &Kernels() {
+    static const SKernels Selected = SelectKernels();
+    return Selected;
+}
+
+// Most fields have no surrounding whitespace, so check the edges first
+size_t SkipWhitespace(const char *data, size_t length) {
+    if (!length || !IsWhitespace(data[0])) {
+        return 0;
+    }
+    return Kernels().Skip(data, length);
+}
+
+size_t SkipWhitespaceBack(const char *data, size_t length) {
+    if (!length || !IsWhitespace(data[length - 1])) {
+        return length;
+    }
+    return Kernels().SkipBack(data, length);
+}
+
+}
+
+std::string_view SliceView(std::string_view text, ssize_t begin, ssize_t finish) noexcept {
+    ssize_t length = text.length();
+    if (finish == 0) finish = length;
+    if (begin < 0) begin += length;
+    if (finish < 0) finish += length;
+    begin = std::clamp<ssize_t>(begin, 0, length);
+    finish = std::clamp<ssize_t>(finish, 0, length);
+    if (begin > finish) return std::string_view();
     return text.substr(begin, finish - begin);
 }
 
-std::string TitleCase(const std::string &text) noexcept {
-    if (text.empty()) return text;
-    std::string modified = text;
-    if (std::isalpha(modified[0]))
-        modified[0] = std::toupper(modified[0]);
-    std::transform(modified.begin() + 1, modified.end(), modified.begin() + 1, ::tolower);
+std::string_view LStripView(std::string_view text) noexcept {
+    return text.substr(SkipWhitespace(text.data(), text.length()));
+}
+
+std::string_view RStripView(std::string_view text) noexcept {
+    return text.substr(0, SkipWhitespaceBack(text.data(), text.length()));
+}
+
+std::string_view StripView(std::string_view text) noexcept {
+    return LStripView(RStripView(text));
+}
+
+std::size_t SplitView(std::string_view text, std::vector<std::string_view> &parts, std::string_view delimiter) noexcept {
+    parts.clear();
+    for (auto part : SplitRange(text, delimiter)) {
+        parts.push_back(part);
+    }
+    return parts.size();
+}
+
+void UpperInPlace(std::string &text) noexcept {
+    Kernels().Convert(text.data(), text.data(), text.length(), 'a');
+}
+
+void LowerInPlace(std::string &text) noexcept {
+    Kernels().Convert(text.data(), text.data(), text.length(), 'A');
+}
+
+void StripInPlace(std::string &text) noexcept {
+    text.erase(SkipWhitespaceBack(text.data(), text.length()));
+    text.erase(0, SkipWhitespace(text.data(), text.length()));
+}
+
+void AppendUpper(std::string &buffer, std::string_view text) noexcept {
+    size_t offset = buffer.size();
+    buffer.resize(offset + text.size());
+    Kernels().Convert(text.data(), buffer.data() + offset, text.size(), 'a');
+}
+
+void AppendLower(std::string &buffer, std::string_view text) noexcept {
+    size_t offset = buffer.size();
+    buffer.resize(offset + text.size());
+    Kernels().Convert(text.data(), buffer.data() + offset, text.size(), 'A');
+}
+
+void AppendReplace(std::string &buffer, std::string_view text, std::string_view old_value, std::string_view new_value) noexcept {
+    if (old_value.empty()) {
+        buffer.append(text);
+        return;
+    }
+    size_t start = 0;
+    size_t position;
+    while ((position = text.find(old_value, start)) != std::string_view::npos) {
+        buffer.append(text.substr(start, position - start));
+        buffer.append(new_value);
+        start = position + old_value.length();
+    }
+    buffer.append(text.substr(start));
+}
+
+CSplitIterator::CSplitIterator(std::string_view text, std::string_view delimiter) noexcept
+    : DRest(text), DSeparator(delimiter), DDone(text.empty()) {
+    if (!DDone) {
+        Advance();
+    }
+}
+
+void CSplitIterator::Advance() noexcept {
+    if (DSeparator.empty()) {
+        size_t start = std::min(DRest.find_first_not_of(Whitespace), DRest.length());
+        DRest.remove_prefix(start);
+        if (DRest.empty()) {
+            DDone = true;
+            return;
+        }
+        size_t end = std::min(DRest.find_first_of(Whitespace), DRest.length());
+        DCurrent = DRest.substr(0, end);
+        DRest.remove_prefix(end);
+        return;
+    }
+    // A rest without data marks that the last part was already returned
+    if (!DRest.data()) {
+        DDone = true;
+        return;
+    }
+    size_t end = DRest.find(DSeparator);
+    if (end == std::string_view::npos) {
+        DCurrent = DRest;
+        DRest = std::string_view();
+        return;
+    }
+    DCurrent = DRest.substr(0, end);
+    DRest.remove_prefix(end + DSeparator.length());
+}
+
+std::string Slice(std::string_view text, ssize_t begin, ssize_t finish) noexcept {
+    return std::string(SliceView(text, begin, finish));
+}
+
+// Only the first character changes, the rest is kept as is
+std::string Capitalize(std::string_view text) noexcept {
+    std::string modified(text);
+    if (!modified.empty()) {
+        modified[0] = std::toupper(static_cast<unsigned char>(modified[0]));
+    }
     return modified;
 }
 
-std::string ToUpper(const std::string &text) noexcept {
-    std::string modified = text;
-    std::transform(modified.begin(), modified.end(), modified.begin(), ::toupper);
+std::string Upper(std::string_view text) noexcept {
+    std::string modified;
+    AppendUpper(modified, text);
     return modified;
 }
 
-std::string ToLower(const std::string &text) noexcept {
-    std::string modified = text;
-    std::transform(modified.begin(), modified.end(), modified.begin(), ::tolower);
+std::string Lower(std::string_view text) noexcept {
+    std::string modified;
+    AppendLower(modified, text);
     return modified;
 }
 
-std::string TrimLeft(const std::string &text) noexcept {
-    size_t start = text.find_first_not_of(" \t\n\r");
-    return (start == std::string::npos) ? "" : text.substr(start);
+std::string LStrip(std::string_view text) noexcept {
+    return std::string(LStripView(text));
 }
 
-std::string TrimRight(const std::string &text) noexcept {
-    size_t end = text.find_last_not_of(" \t\n\r");
-    return (end == std::string::npos) ? "" : text.substr(0, end + 1);
+std::string RStrip(std::string_view text) noexcept {
+    return std::string(RStripView(text));
 }
 
-std::string Trim(const std::string &text) noexcept {
-    return TrimLeft(TrimRight(text));
+std::string Strip(std::string_view text) noexcept {
+    return std::string(StripView(text));
 }
 
-std::string AlignCenter(const std::string &text, int width, char filler) noexcept {
-    int padding = width - text.length();
-    if (padding <= 0) return text;
+std::string Center(std::string_view text, int width, char filler) noexcept {
+    int padding = width - static_cast<int>(text.length());
+    if (padding <= 0) return std::string(text);
     int left_padding = padding / 2;
-    int right_padding = padding - left_padding;
-    return std::string(left_padding, filler) + text + std::string(right_padding, filler);
+    std::string result(width, filler);
+    std::copy(text.begin(), text.end(), result.begin() + left_padding);
+    return result;
 }
 
-std::string AlignLeft(const std::string &text, int width, char filler) noexcept {
-    return text + std::string(std::max(0, width - static_cast<int>(text.size())), filler);
+std::string LJust(std::string_view text, int width, char filler) noexcept {
+    std::string result(text);
+    result.append(std::max(0, width - static_cast<int>(text.size())), filler);
+    return result;
 }
 
-std::string AlignRight(const std::string &text, int width, char filler) noexcept {
-    return std::string(std::max(0, width - static_cast<int>(text.size())), filler) + text;
+std::string RJust(std::string_view text, int width, char filler) noexcept {
+    std::string result(std::max(0, width - static_cast<int>(text.size())), filler);
+    result.append(text);
+    return result;
 }
 
-std::string Substitute(const std::string &text, const std::string &old_value, const std::string &new_value) noexcept {
-    if (old_value.empty()) return text;
-    std::string modified = text;
-    size_t position = 0;
-    while ((position = modified.find(old_value, position)) != std::string::npos) {
-        modified.replace(position, old_value.length(), new_value);
-        position += new_value.length();
-    }
+std::string Replace(std::string_view text, std::string_view old_value, std::string_view new_value) noexcept {
+    std::string modified;
+    modified.reserve(text.size());
+    AppendReplace(modified, text, old_value, new_value);
     return modified;
 }
 
-std::vector<std::string> Tokenize(const std::string &text, const std::string &delimiter) noexcept {
+std::vector<std::string> Split(std::string_view text, std::string_view delimiter) noexcept {
     std::vector<std::string> result;
-    if (text.empty()) return result;
-
-    if (delimiter.empty()) {
-        std::istringstream stream(text);
-        std::string token;
-        while (stream >> token) {
-            result.push_back(token);
-        }
-        return result;
+    for (auto part : SplitRange(text, delimiter)) {
+        result.emplace_back(part);
     }
-
-    size_t start = 0;
-    size_t end = text.find(delimiter);
-    while (end != std::string::npos) {
-        result.push_back(text.substr(start, end - start));
-        start = end + delimiter.length();
-        end = text.find(delimiter, start);
-    }
-    result.push_back(text.substr(start));
     return result;
 }
 
-std::string Concatenate(const std::string &separator, const std::vector<std::string> &tokens) noexcept {
+std::string Join(std::string_view separator, const std::vector<std::string> &tokens) noexcept {
     if (tokens.empty()) return "";
-    std::string result = tokens[0];
+    size_t length = separator.length() * (tokens.size() - 1);
+    for (auto &token : tokens) {
+        length += token.length();
+    }
+    std::string result;
+    result.reserve(length);
+    result.append(tokens[0]);
     for (size_t index = 1; index < tokens.size(); ++index) {
-        result += separator + tokens[index];
+        result.append(separator);
+        result.append(tokens[index]);
     }
     return result;
 }
 
-std::string ExpandTabulation(const std::string &text, int tabsize) noexcept {
+std::string ExpandTabs(std::string_view text, int tabsize) noexcept {
     std::string result;
+    result.reserve(text.size());
     int column = 0;
-    if (tabsize == 0) {
-        for (char character : text) {
-            if (character != '\t') {
-                result += character;
-            }
-        }
-        return result;
-    }
     for (char character : text) {
         if (character == '\t') {
-            int spaces = tabsize - (column % tabsize);
-            column += spaces;
-            result.append(spaces, ' ');
+            if (tabsize > 0) {
+                int spaces = tabsize - (column % tabsize);
+                column += spaces;
+                result.append(spaces, ' ');
+            }
+        } else if (character == '\n' || character == '\r') {
+            result += character;
+            column = 0;
         } else {
             result += character;
             column++;
@@ -133,26 +452,179 @@ std::string ExpandTabulation(const std::string &text, int tabsize) noexcept {
     return result;
 }
 
-int ComputeEditDistance(const std::string &first, const std::string &second, bool ignore_case) noexcept {
-    std::string left = ignore_case ? ToLower(first) : first;
-    std::string right = ignore_case ? ToLower(second) : second;
+static char FoldCase(char character, bool ignore_case) noexcept {
+    return ignore_case ? std::tolower(static_cast<unsigned char>(character)) : character;
+}
+
+// Match masks of a pattern of at most 64 characters for the bit-parallel
+// distance of Myers and Hyyro, built once and reused for every text
+struct SBitPattern {
+    uint64_t Masks[256];
+    size_t Length;
+
+    SBitPattern(std::string_view pattern, bool ignore_case) noexcept : Masks{}, Length(pattern.length()) {
+        for (size_t index = 0; index < Length; index++) {
+            unsigned char character = pattern[index];
+            uint64_t bit = uint64_t(1) << index;
+            if (ignore_case) {
+                Masks[std::tolower(character)] |= bit;
+                Masks[std::toupper(character)] |= bit;
+            } else {
+                Masks[character] |= bit;
+            }
+        }
+    }
 
-    std::vector<std::vector<int>> table(left.length() + 1, std::vector<int>(right.length() + 1));
+    // Stops once the distance cannot end up at or below limit and returns limit + 1
+    int Distance(std::string_view text, int limit) const noexcept {
+        // The distance is at most the longer length, so a larger limit
+        // changes nothing and limit + 1 cannot overflow
+        limit = std::min<size_t>(limit, std::max(Length, text.length()));
+        if (!Length) {
+            return std::min<size_t>(text.length(), limit + 1);
+        }
+        uint64_t positive = ~uint64_t(0);
+        uint64_t negative = 0;
+        uint64_t last = uint64_t(1) << (Length - 1);
+        int score = Length;
+        int remaining = text.length();
+        for (unsigned char character : text) {
+            uint64_t equal = Masks[character];
+            uint64_t vertical = equal | negative;
+            uint64_t horizontal = (((equal & positive) + positive) ^ positive) | equal;
+            uint64_t horizontal_positive = negative | ~(horizontal | positive);
+            uint64_t horizontal_negative = positive & horizontal;
+            if (horizontal_positive & last) {
+                score++;
+            } else if (horizontal_negative & last) {
+                score--;
+            }
+            remaining--;
+            if (score - remaining > limit) {
+                return limit + 1;
+            }
+            horizontal_positive = (horizontal_positive << 1) | 1;
+            horizontal_negative <<= 1;
+            positive = horizontal_negative | ~(vertical | horizontal_positive);
+            negative = horizontal_positive & vertical;
+        }
+        return score;
+    }
+};
 
-    for (size_t i = 0; i <= left.length(); i++) table[i][0] = i;
-    for (size_t j = 0; j <= right.length(); j++) table[0][j] = j;
+// Two-row table restricted to the diagonals within limit of the main one
+static int BandedEditDistance(std::string_view first, std::string_view second, int limit, bool ignore_case) noexcept {
+    int over = limit + 1;
+    std::vector<int> previous(second.length() + 1);
+    std::vector<int> current(second.length() + 1);
+    for (size_t j = 0; j <= second.length(); j++) {
+        previous[j] = std::min<size_t>(j, over);
+    }
 
-    for (size_t i = 1; i <= left.length(); i++) {
-        for (size_t j = 1; j <= right.length(); j++) {
-            table[i][j] = std::min({
-                table[i - 1][j] + 1,
-                table[i][j - 1] + 1,
-                table[i - 1][j - 1] + (left[i - 1] != right[j - 1])
+    for (size_t i = 1; i <= first.length(); i++) {
+        size_t low = i > size_t(limit) ? i - limit : 1;
+        size_t high = std::min(second.length(), i + limit);
+        current[low - 1] = low == 1 ? std::min<size_t>(i, over) : over;
+        int row_minimum = current[low - 1];
+        char left = FoldCase(first[i - 1], ignore_case);
+        for (size_t j = low; j <= high; j++) {
+            current[j] = std::min({
+                previous[j] + 1,
+                current[j - 1] + 1,
+                previous[j - 1] + (left != FoldCase(second[j - 1], ignore_case)),
+                over
             });
+            row_minimum = std::min(row_minimum, current[j]);
+        }
+        if (high < second.length()) {
+            current[high + 1] = over;
         }
+        if (row_minimum > limit) {
+            return over;
+        }
+        std::swap(previous, current);
     }
+    return previous[second.length()];
+}
 
-    return table[left.length()][right.length()];
+int EditDistance(std::string_view first, std::string_view second, bool ignore_case) noexcept {
+    if (first.length() > second.length()) {
+        std::swap(first, second);
+    }
+    if (first.length() <= 64) {
+        return SBitPattern(first, ignore_case).Distance(second, second.length());
+    }
+    return BandedEditDistance(first, second, second.length(), ignore_case);
+}
+
+int BoundedEditDistance(std::string_view first, std::string_view second, int max_distance, bool ignore_case) noexcept {
+    if (max_distance < 0) {
+        return first == second ? 0 : 1;
+    }
+    if (first.length() > second.length()) {
+        std::swap(first, second);
+    }
+    // No distance exceeds the longer length, clamping keeps max_distance + 1
+    // from overflowing
+    max_distance = std::min<size_t>(max_distance, second.length());
+    if (second.length() - first.length() > size_t(max_distance)) {
+        return max_distance + 1;
+    }
+    if (first.length() <= 64) {
+        return SBitPattern(first, ignore_case).Distance(second, max_distance);
+    }
+    return BandedEditDistance(first, second, max_distance, ignore_case);
+}
+
+std::vector<SEditMatch> FindMatches(std::string_view query, const std::vector<std::string> &candidates, int max_distance, bool ignore_case, std::size_t threads) noexcept {
+    std::vector<SEditMatch> matches;
+    if (max_distance < 0) {
+        return matches;
+    }
+    bool short_query = query.length() <= 64;
+    SBitPattern pattern(short_query ? query : std::string_view(), ignore_case);
+
+    auto match_range = [&](size_t begin, size_t end, std::vector<SEditMatch> &result) {
+        for (size_t index = begin; index < end; index++) {
+            std::string_view candidate = candidates[index];
+            size_t difference = std::max(candidate.length(), query.length()) - std::min(candidate.length(), query.length());
+            if (difference > size_t(max_distance)) {
+                continue;
+            }
+            int distance = short_query ? pattern.Distance(candidate, max_distance)
+                                       : BoundedEditDistance(query, candidate, max_distance, ignore_case);
+            if (distance <= max_distance) {
+                result.push_back({index, distance});
+            }
+        }
+    };
+
+    if (!threads) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, candidates.size()));
+    if (threads == 1) {
+        match_range(0, candidates.size(), matches);
+        return matches;
+    }
+
+    // Each thread takes a contiguous range so the results stay in order
+    std::vector<std::vector<SEditMatch>> partial(threads);
+    std::vector<std::thread> workers;
+    size_t range = (candidates.size() + threads - 1) / threads;
+    for (size_t worker = 1; worker < threads; worker++) {
+        size_t begin = std::min(candidates.size(), worker * range);
+        size_t end = std::min(candidates.size(), begin + range);
+        workers.emplace_back(match_range, begin, end, std::ref(partial[worker]));
+    }
+    match_range(0, std::min(candidates.size(), range), partial[0]);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (auto &result : partial) {
+        matches.insert(matches.end(), result.begin(), result.end());
+    }
+    return matches;
 }
 
 } // namespace StringUtils
@@ -0,0 +1,173 @@
+#include "TextEscaper.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TEXTESCAPER_X86
+#include <immintrin.h>
+#endif
+
+namespace{
+
+using TFindFunction = std::size_t (*)(const char *, std::size_t, const char *, std::size_t);
+
+std::size_t ScalarFind(const char *data, std::size_t length, const char *special, std::size_t count){
+    for(std::size_t Index = 0; Index < length; Index++){
+        for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+            if(data[Index] == special[SpecialIndex]){
+                return Index;
+            }
+        }
+    }
+    return length;
+}
+
+#ifdef TEXTESCAPER_X86
+
+__attribute__((target("sse2")))
+std::size_t SSE2Find(const char *data, std::size_t length, const char *special, std::size_t count){
+    __m128i Special[8];
+    for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+        Special[SpecialIndex] = _mm_set1_epi8(special[SpecialIndex]);
+    }
+    std::size_t Index = 0;
+    for(; Index + 16 <= length; Index += 16){
+        __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + Index));
+        __m128i Matches = _mm_setzero_si128();
+        for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+            Matches = _mm_or_si128(Matches, _mm_cmpeq_epi8(Block, Special[SpecialIndex]));
+        }
+        uint32_t Mask = _mm_movemask_epi8(Matches);
+        if(Mask){
+            return Index + __builtin_ctz(Mask);
+        }
+    }
+    return Index + ScalarFind(data + Index, length - Index, special, count);
+}
+
+// Clears the upper register halves before returning, callers may use legacy
+// SSE encodings and would stall on the transition. The tail is handled with a
+// 128 bit VEX step and scalar code instead of the SSE2 kernel.
+__attribute__((target("avx2")))
+std::size_t AVX2Find(const char *data, std::size_t length, const char *special, std::size_t count){
+    __m256i Special[8];
+    for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+        Special[SpecialIndex] = _mm256_set1_epi8(special[SpecialIndex]);
+    }
+    std::size_t Index = 0;
+    uint32_t Mask = 0;
+    for(; Index + 32 <= length; Index += 32){
+        __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + Index));
+        __m256i Matches = _mm256_setzero_si256();
+        for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+            Matches = _mm256_or_si256(Matches, _mm256_cmpeq_epi8(Block, Special[SpecialIndex]));
+        }
+        Mask = _mm256_movemask_epi8(Matches);
+        if(Mask){
+            break;
+        }
+    }
+    if(!Mask && (Index + 16 <= length)){
+        __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + Index));
+        __m128i Matches = _mm_setzero_si128();
+        for(std::size_t SpecialIndex = 0; SpecialIndex < count; SpecialIndex++){
+            Matches = _mm_or_si128(Matches, _mm_cmpeq_epi8(Block, _mm256_castsi256_si128(Special[SpecialIndex])));
+        }
+        Mask = _mm_movemask_epi8(Matches);
+        if(!Mask){
+            Index += 16;
+        }
+    }
+    _mm256_zeroupper();
+    if(Mask){
+        return Index + __builtin_ctz(Mask);
+    }
+    return Index + ScalarFind(data + Index, length - Index, special, count);
+}
+
+#endif
+
+TFindFunction SelectFind(){
+#ifdef TEXTESCAPER_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        return AVX2Find;
+    }
+    if(__builtin_cpu_supports("sse2")){
+        return SSE2Find;
+    }
+#endif
+    return ScalarFind;
+}
+
+std::size_t Find(const char *data, std::size_t length, const char *special, std::size_t count){
+    static const TFindFunction Selected = SelectFind();
+    return Selected(data, length, special, count);
+}
+
+// Input is escaped in blocks so the sink reservation stays bounded
+const std::size_t WriteBlockSize = 4096;
+
+}
+
+CTextEscaper::CTextEscaper(std::initializer_list< std::pair< char, std::string_view > > replacements)
+    : DSpecialCount(0), DMaxReplacement(1){
+    for(auto &Replacement : replacements){
+        if(DSpecialCount == MaxSpecial){
+            break;
+        }
+        DSpecial[DSpecialCount++] = Replacement.first;
+        DReplacements[static_cast<unsigned char>(Replacement.first)] = std::string(Replacement.second);
+        DMaxReplacement = std::max(DMaxReplacement, Replacement.second.size());
+    }
+}
+
+std::size_t CTextEscaper::FindSpecial(const char *data, std::size_t length) const noexcept{
+    return Find(data, length, DSpecial, DSpecialCount);
+}
+
+std::size_t CTextEscaper::EscapedLength(std::string_view text) const noexcept{
+    std::size_t Length = text.size();
+    std::size_t Index = 0;
+    while((Index += FindSpecial(text.data() + Index, text.size() - Index)) < text.size()){
+        Length += DReplacements[static_cast<unsigned char>(text[Index])].size() - 1;
+        Index++;
+    }
+    return Length;
+}
+
+std::size_t CTextEscaper::Escape(std::string_view text, char *buf) const noexcept{
+    char *Output = buf;
+    std::size_t Index = 0;
+    while(Index < text.size()){
+        std::size_t Next = Index + FindSpecial(text.data() + Index, text.size() - Index);
+        std::memcpy(Output, text.data() + Index, Next - Index);
+        Output += Next - Index;
+        if(Next == text.size()){
+            break;
+        }
+        const std::string &Replacement = DReplacements[static_cast<unsigned char>(text[Next])];
+        std::memcpy(Output, Replacement.data(), Replacement.size());
+        Output += Replacement.size();
+        Index = Next + 1;
+    }
+    return Output - buf;
+}
+
+void CTextEscaper::Append(std::string &str, std::string_view text) const{
+    std::size_t Offset = str.size();
+    str.resize(Offset + text.size() * DMaxReplacement);
+    str.resize(Offset + Escape(text, &str[Offset]));
+}
+
+bool CTextEscaper::Write(CDataSink &sink, std::string_view text) const noexcept{
+    while(!text.empty()){
+        std::size_t Length = std::min(text.size(), WriteBlockSize);
+        char *Buffer = sink.Reserve(Length * DMaxReplacement);
+        if(!Buffer || !sink.Commit(Escape(text.substr(0, Length), Buffer))){
+            return false;
+        }
+        text.remove_prefix(Length);
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#include "WorkerPool.h"
+
+CWorkerPool::CWorkerPool(size_t threads) : DTaskCount(0), DNextTask(0), DActive(0), DGeneration(0), DStop(false) {
+    for (size_t index = 1; index < threads; index++) {
+        DThreads.emplace_back(&CWorkerPool::Worker, this);
+    }
+}
+
+CWorkerPool::~CWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(DMutex);
+        DStop = true;
+    }
+    DStart.notify_all();
+    for (auto& thread : DThreads) {
+        thread.join();
+    }
+}
+
+void CWorkerPool::RunTasks() {
+    size_t task;
+    while ((task = DNextTask++) < DTaskCount) {
+        DTask(task);
+    }
+}
+
+void CWorkerPool::Worker() {
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(DMutex);
+    while (true) {
+        DStart.wait(lock, [&] { return DStop || generation != DGeneration; });
+        if (DStop) {
+            return;
+        }
+        generation = DGeneration;
+        lock.unlock();
+        RunTasks();
+        lock.lock();
+        if (--DActive == 0) {
+            DDone.notify_one();
+        }
+    }
+}
+
+size_t CWorkerPool::Size() const {
+    return DThreads.size() + 1;
+}
+
+void CWorkerPool::Run(size_t count, std::function<void(size_t)> task) {
+    if (DThreads.empty() || count < 2) {
+        for (size_t index = 0; index < count; index++) {
+            task(index);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(DMutex);
+        DTask = std::move(task);
+        DTaskCount = count;
+        DNextTask = 0;
+        DActive = DThreads.size();
+        DGeneration++;
+    }
+    DStart.notify_all();
+    RunTasks();
+    std::unique_lock<std::mutex> lock(DMutex);
+    DDone.wait(lock, [&] { return DActive == 0; });
+}
@@ -0,0 +1,214 @@
+#include "XMLDocument.h"
+#include "XMLHandler.h"
+
+// Appends nodes as the reader parses them, keeping the open elements with
+// their last child so new nodes can be linked without searching
+class CXMLDocument::CBuilder : public CXMLHandler{
+    private:
+        struct SOpen{
+            uint32_t DNode;
+            uint32_t DLastChild;
+            // Child before the last one, to unlink a dropped text node
+            uint32_t DPreviousChild;
+        };
+
+        CXMLDocument &DDocument;
+        CXMLNameTable &DReaderNames;
+        // Document atom of each reader atom seen so far
+        std::vector< uint32_t > DAtoms;
+        // Bottom entry stands for the top level
+        std::vector< SOpen > DOpen;
+
+        uint32_t Atom(uint32_t readeratom){
+            if(readeratom >= DAtoms.size()){
+                DAtoms.resize(readeratom + 1, CXMLNameTable::InvalidAtom);
+            }
+            if(DAtoms[readeratom] == CXMLNameTable::InvalidAtom){
+                DAtoms[readeratom] = DDocument.DNames.Intern(DReaderNames.Name(readeratom));
+            }
+            return DAtoms[readeratom];
+        };
+
+        bool AppendText(std::string_view text, SString &str){
+            if(DDocument.DArena.size() + text.size() > UINT32_MAX){
+                return false;
+            }
+            str.DOffset = DDocument.DArena.size();
+            str.DLength = text.size();
+            DDocument.DArena.append(text);
+            return true;
+        };
+
+        bool AppendNode(const SNode &node){
+            if(DDocument.DNodes.size() >= InvalidNode){
+                return false;
+            }
+            uint32_t Index = DDocument.DNodes.size();
+            DDocument.DNodes.push_back(node);
+            DDocument.DNodes.back().DParent = DOpen.back().DNode;
+            if(DOpen.back().DLastChild != InvalidNode){
+                DDocument.DNodes[DOpen.back().DLastChild].DNextSibling = Index;
+            }
+            else if(DOpen.back().DNode != InvalidNode){
+                DDocument.DNodes[DOpen.back().DNode].DFirstChild = Index;
+            }
+            DOpen.back().DPreviousChild = DOpen.back().DLastChild;
+            DOpen.back().DLastChild = Index;
+            return true;
+        };
+
+        // Called when a run of character data ends, text that is only
+        // whitespace is removed the way ReadEntity skips it. The text node is
+        // still the last node and owns the end of the arena.
+        void EndText(){
+            uint32_t Last = DOpen.back().DLastChild;
+            if(Last == InvalidNode || DDocument.IsElement(Last) || DDocument.Text(Last).find_first_not_of(" \t\n\r") != std::string_view::npos){
+                return;
+            }
+            DDocument.DArena.resize(DDocument.DNodes[Last].DText.DOffset);
+            DDocument.DNodes.pop_back();
+            uint32_t Previous = DOpen.back().DPreviousChild;
+            if(Previous != InvalidNode){
+                DDocument.DNodes[Previous].DNextSibling = InvalidNode;
+            }
+            else if(DOpen.back().DNode != InvalidNode){
+                DDocument.DNodes[DOpen.back().DNode].DFirstChild = InvalidNode;
+            }
+            DOpen.back().DLastChild = Previous;
+            DOpen.back().DPreviousChild = InvalidNode;
+        };
+    public:
+        CBuilder(CXMLDocument &document, CXMLNameTable &readernames) : DDocument(document), DReaderNames(readernames){
+            DOpen.push_back({InvalidNode, InvalidNode, InvalidNode});
+        };
+
+        void Finish(){
+            EndText();
+        };
+
+        bool StartElement(const SXMLEntityView &entity) override{
+            EndText();
+            SNode Node{InvalidNode, InvalidNode, InvalidNode, Atom(entity.DNameAtom), uint32_t(DDocument.DAttributes.size()), uint32_t(entity.DAttributeCount), {0, 0}};
+            for(std::size_t Index = 0; Index < entity.DAttributeCount; Index++){
+                SAttribute Attribute;
+                Attribute.DNameAtom = Atom(entity.DAttributes[Index].DNameAtom);
+                if(!AppendText(entity.DAttributes[Index].DValue, Attribute.DValue)){
+                    return false;
+                }
+                DDocument.DAttributes.push_back(Attribute);
+            }
+            if(!AppendNode(Node)){
+                return false;
+            }
+            DOpen.push_back({uint32_t(DDocument.DNodes.size() - 1), InvalidNode, InvalidNode});
+            return true;
+        };
+
+        bool EndElement(const SXMLEntityView &entity) override{
+            EndText();
+            // Ends of elements opened before the load are ignored
+            if(DOpen.size() > 1){
+                DOpen.pop_back();
+            }
+            return true;
+        };
+
+        bool CharData(std::string_view text) override{
+            uint32_t Last = DOpen.back().DLastChild;
+            if(Last != InvalidNode && !DDocument.IsElement(Last)){
+                // Nothing is added to the arena after a text node while it is
+                // the last child, so it grows in place
+                if(DDocument.DArena.size() + text.size() > UINT32_MAX){
+                    return false;
+                }
+                DDocument.DArena.append(text);
+                DDocument.DNodes[Last].DText.DLength += text.size();
+                return true;
+            }
+            SNode Node{InvalidNode, InvalidNode, InvalidNode, CXMLNameTable::InvalidAtom, 0, 0, {0, 0}};
+            return AppendText(text, Node.DText) && AppendNode(Node);
+        };
+};
+
+bool CXMLDocument::Load(CXMLReader &reader, bool skipcdata){
+    Clear();
+    CBuilder Builder(*this, reader.NameTable());
+    bool Result = reader.Parse(Builder, skipcdata);
+    Builder.Finish();
+    return Result;
+}
+
+void CXMLDocument::Clear() noexcept{
+    DNodes.clear();
+    DAttributes.clear();
+    DArena.clear();
+    DNames = CXMLNameTable();
+}
+
+std::string CXMLDocument::TextContent(uint32_t node) const{
+    std::string Result;
+    for(uint32_t Index = node, End = SubtreeEnd(node); Index < End; Index++){
+        if(!IsElement(Index)){
+            Result.append(View(DNodes[Index].DText));
+        }
+    }
+    return Result;
+}
+
+uint32_t CXMLDocument::FirstChild(uint32_t node, uint32_t atom) const noexcept{
+    if(atom == CXMLNameTable::InvalidAtom){
+        return InvalidNode;
+    }
+    uint32_t Child = DNodes[node].DFirstChild;
+    while(Child != InvalidNode && DNodes[Child].DNameAtom != atom){
+        Child = DNodes[Child].DNextSibling;
+    }
+    return Child;
+}
+
+uint32_t CXMLDocument::NextSibling(uint32_t node, uint32_t atom) const noexcept{
+    if(atom == CXMLNameTable::InvalidAtom){
+        return InvalidNode;
+    }
+    uint32_t Sibling = DNodes[node].DNextSibling;
+    while(Sibling != InvalidNode && DNodes[Sibling].DNameAtom != atom){
+        Sibling = DNodes[Sibling].DNextSibling;
+    }
+    return Sibling;
+}
+
+uint32_t CXMLDocument::SubtreeEnd(uint32_t node) const noexcept{
+    // The subtree ends where the next sibling of node or of its closest
+    // ancestor that has one begins
+    while(node != InvalidNode){
+        if(DNodes[node].DNextSibling != InvalidNode){
+            return DNodes[node].DNextSibling;
+        }
+        node = DNodes[node].DParent;
+    }
+    return DNodes.size();
+}
+
+bool CXMLDocument::AttributeExists(uint32_t node, uint32_t atom) const noexcept{
+    if(!IsElement(node)){
+        return false;
+    }
+    for(uint32_t Index = DNodes[node].DFirstAttribute, End = Index + DNodes[node].DAttributeCount; Index < End; Index++){
+        if(DAttributes[Index].DNameAtom == atom){
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string_view CXMLDocument::AttributeValue(uint32_t node, uint32_t atom) const noexcept{
+    if(!IsElement(node)){
+        return std::string_view();
+    }
+    for(uint32_t Index = DNodes[node].DFirstAttribute, End = Index + DNodes[node].DAttributeCount; Index < End; Index++){
+        if(DAttributes[Index].DNameAtom == atom){
+            return View(DAttributes[Index].DValue);
+        }
+    }
+    return std::string_view();
+}
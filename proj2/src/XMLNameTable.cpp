@@ -0,0 +1,25 @@
+#include "XMLNameTable.h"
+
+uint32_t CXMLNameTable::Intern(std::string_view name){
+    auto Search = DAtoms.find(name);
+    if(Search != DAtoms.end()){
+        return Search->second;
+    }
+    uint32_t Atom = DNames.size();
+    DNames.emplace_back(name);
+    DAtoms.emplace(DNames.back(), Atom);
+    return Atom;
+}
+
+uint32_t CXMLNameTable::Find(std::string_view name) const noexcept{
+    auto Search = DAtoms.find(name);
+    return Search == DAtoms.end() ? InvalidAtom : Search->second;
+}
+
+std::string_view CXMLNameTable::Name(uint32_t atom) const noexcept{
+    return atom < DNames.size() ? std::string_view(DNames[atom]) : std::string_view();
+}
+
+std::size_t CXMLNameTable::Size() const noexcept{
+    return DNames.size();
+}
@@ -0,0 +1,128 @@
+#include "XMLPathFilter.h"
+#include <algorithm>
+#include <cstring>
+
+// Like find, but skips characters inside quoted predicate values
+static size_t FindUnquoted(std::string_view text, char ch, size_t start = 0){
+    char Quote = '\0';
+    for(size_t Index = start; Index < text.size(); Index++){
+        if(Quote){
+            if(text[Index] == Quote){
+                Quote = '\0';
+            }
+        }
+        else if(text[Index] == ch){
+            return Index;
+        }
+        else if(text[Index] == '\'' || text[Index] == '"'){
+            Quote = text[Index];
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool CXMLPathFilter::AddPath(std::string_view expression){
+    size_t StepCount = DSteps.size();
+    size_t PathCount = DFirstSteps.size();
+    while(true){
+        size_t Separator = FindUnquoted(expression, '|');
+        if(!AddSinglePath(expression.substr(0, Separator))){
+            DSteps.resize(StepCount);
+            DFirstSteps.resize(PathCount);
+            return false;
+        }
+        if(Separator == std::string_view::npos){
+            return true;
+        }
+        expression.remove_prefix(Separator + 1);
+    }
+}
+
+bool CXMLPathFilter::AddSinglePath(std::string_view path){
+    size_t First = DSteps.size();
+    size_t Index = 0;
+    while(Index < path.size()){
+        if(path[Index] != '/'){
+            return false;
+        }
+        SStep Step{false, "", {}, false};
+        Index++;
+        if(Index < path.size() && path[Index] == '/'){
+            Step.DDescendant = true;
+            Index++;
+        }
+        size_t NameEnd = std::min(path.find_first_of("/[", Index), path.size());
+        Step.DName = std::string(path.substr(Index, NameEnd - Index));
+        if(Step.DName.empty()){
+            return false;
+        }
+        if(Step.DName == "*"){
+            Step.DName.clear();
+        }
+        Index = NameEnd;
+        while(Index < path.size() && path[Index] == '['){
+            size_t Close = FindUnquoted(path, ']', Index);
+            if(Close == std::string_view::npos || path[Index + 1] != '@'){
+                return false;
+            }
+            std::string_view Predicate = path.substr(Index + 2, Close - Index - 2);
+            size_t Equals = Predicate.find('=');
+            SPredicate Attribute{std::string(Predicate.substr(0, Equals)), "", Equals != std::string_view::npos};
+            if(Attribute.DHasValue){
+                std::string_view Value = Predicate.substr(Equals + 1);
+                if(Value.size() < 2 || (Value.front() != '\'' && Value.front() != '"') || Value.back() != Value.front()){
+                    return false;
+                }
+                Attribute.DValue = std::string(Value.substr(1, Value.size() - 2));
+            }
+            if(Attribute.DName.empty()){
+                return false;
+            }
+            Step.DPredicates.push_back(std::move(Attribute));
+            Index = Close + 1;
+        }
+        DSteps.push_back(std::move(Step));
+    }
+    if(DSteps.size() == First){
+        return false;
+    }
+    DSteps.back().DLast = true;
+    DFirstSteps.push_back(First);
+    return true;
+}
+
+bool CXMLPathFilter::Empty() const noexcept{
+    return DFirstSteps.empty();
+}
+
+const std::vector< uint32_t > &CXMLPathFilter::FirstSteps() const noexcept{
+    return DFirstSteps;
+}
+
+bool CXMLPathFilter::Descendant(uint32_t step) const noexcept{
+    return DSteps[step].DDescendant;
+}
+
+bool CXMLPathFilter::Last(uint32_t step) const noexcept{
+    return DSteps[step].DLast;
+}
+
+bool CXMLPathFilter::Matches(uint32_t step, const char *name, const char **attributes) const noexcept{
+    const SStep &Step = DSteps[step];
+    if(!Step.DName.empty() && Step.DName != name){
+        return false;
+    }
+    for(auto &Predicate : Step.DPredicates){
+        bool Found = false;
+        for(size_t Index = 0; attributes[Index]; Index += 2){
+            if(Predicate.DName == attributes[Index]){
+                Found = !Predicate.DHasValue || Predicate.DValue == attributes[Index + 1];
+                break;
+            }
+        }
+        if(!Found){
+            return false;
+        }
+    }
+    return true;
+}
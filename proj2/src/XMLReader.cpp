@@ -1,97 +1,400 @@
 #include "XMLReader.h"
 #include <expat.h>
-#include <stack>
+#include <algorithm>
 #include <cstring>
 
 struct CXMLReader::SImplementation {
     std::shared_ptr<CDataSource> DataSource;
     XML_Parser Parser;
-    std::vector<SXMLEntity> EntityQueue;
+    // Parsed entities are compact records whose text lives in Arena and whose
+    // names are atoms in Names. Records are only appended while the queue is
+    // empty, so all storage is recycled at the start of every chunk.
+    struct SEntityRecord {
+        SXMLEntity::EType Type;
+        uint32_t NameAtom;
+        size_t DataOffset;
+        size_t DataLength;
+        size_t AttributeBegin;
+        size_t AttributeCount;
+    };
+    
+    struct SAttributeRecord {
+        uint32_t NameAtom;
+        size_t ValueOffset;
+        size_t ValueLength;
+    };
+    
+    CXMLNameTable Names;
+    std::vector<SEntityRecord> Records;
+    std::vector<SAttributeRecord> AttributeRecords;
+    std::string Arena;
+    size_t QueueHead;
+    std::vector<SXMLAttributeView> AttributeViews;
+    std::vector<char> Buffer;
+    size_t ChunkSize;
+    size_t MaxChunkSize;
+    bool Finished;
     bool Error;
+    // Set while Parse dispatches straight to a handler
+    CXMLHandler* Handler;
+    bool SkipCData;
+    bool Stopped;
+    // Path filter state. FilterStates holds the steps that may match at each
+    // open depth, starting at the offsets in FilterOffsets. Inside a match,
+    // or inside a subtree no step can match, only the depth is tracked.
+    CXMLPathFilter Filter;
+    bool Filtering;
+    std::vector<uint32_t> FilterStates;
+    std::vector<size_t> FilterOffsets;
+    size_t MatchDepth;
+    size_t SkipDepth;
+    SIOStatsCollector Stats;
+    
+    bool QueueEmpty() const {
+        return QueueHead == Records.size();
+    }
+    
+    void RecycleQueue() {
+        Records.clear();
+        AttributeRecords.clear();
+        Arena.clear();
+        QueueHead = 0;
+    }
+    
+    std::string_view ArenaText(size_t offset, size_t length) const {
+        return std::string_view(Arena.data() + offset, length);
+    }
+    
+    size_t StorageCapacity() const {
+        return Records.capacity() + AttributeRecords.capacity() + Arena.capacity() + Buffer.capacity();
+    }
+    
+    const SEntityRecord& PopRecord() {
+        return Records[QueueHead++];
+    }
+    
+    void PushRecord(SXMLEntity::EType type, uint32_t atom, const char* data, size_t length) {
+        Records.push_back({type, atom, Arena.size(), length, AttributeRecords.size(), 0});
+        Arena.append(data, length);
+    }
+    
+    void AddFilterState(uint32_t step, size_t begin) {
+        if(std::find(FilterStates.begin() + begin, FilterStates.end(), step) == FilterStates.end()) {
+            FilterStates.push_back(step);
+        }
+    }
+    
+    // Returns whether the element is inside the filtered output
+    bool FilterStartElement(const XML_Char* name, const XML_Char** attrs) {
+        if(MatchDepth) {
+            MatchDepth++;
+            return true;
+        }
+        if(SkipDepth) {
+            SkipDepth++;
+            return false;
+        }
+        size_t Begin = FilterOffsets.back();
+        size_t End = FilterStates.size();
+        for(size_t Index = Begin; Index < End; Index++) {
+            uint32_t Step = FilterStates[Index];
+            if(Filter.Descendant(Step)) {
+                AddFilterState(Step, End);
+            }
+            if(Filter.Matches(Step, name, attrs)) {
+                if(Filter.Last(Step)) {
+                    FilterStates.resize(End);
+                    MatchDepth = 1;
+                    return true;
+                }
+                AddFilterState(Step + 1, End);
+            }
+        }
+        if(FilterStates.size() == End) {
+            SkipDepth = 1;
+        } else {
+            FilterOffsets.push_back(End);
+        }
+        return false;
+    }
+    
+    bool FilterEndElement() {
+        if(MatchDepth) {
+            MatchDepth--;
+            return true;
+        }
+        if(SkipDepth) {
+            SkipDepth--;
+            return false;
+        }
+        FilterStates.resize(FilterOffsets.back());
+        FilterOffsets.pop_back();
+        return false;
+    }
+    
+    // Stops the parser when the handler asks to, the reader then ends.
+    // Expat may still call back before it stops, those calls are ignored.
+    void Dispatch(bool proceed) {
+        IOSTATS_ONLY(Stats.DStats.DRecords++);
+        if(!proceed) {
+            XML_StopParser(Parser, XML_FALSE);
+            Stopped = true;
+        }
+    }
+    
+    void DispatchStartElement(const XML_Char* name, const XML_Char** attrs) {
+        SXMLEntityView Entity;
+        AttributeViews.clear();
+        for(size_t Index = 0; attrs[Index]; Index += 2) {
+            uint32_t Atom = Names.Intern(attrs[Index]);
+            AttributeViews.push_back({Atom, Names.Name(Atom), attrs[Index + 1]});
+        }
+        Entity.DType = SXMLEntity::EType::StartElement;
+        Entity.DNameAtom = Names.Intern(name);
+        Entity.DNameData = Names.Name(Entity.DNameAtom);
+        Entity.DAttributes = AttributeViews.data();
+        Entity.DAttributeCount = AttributeViews.size();
+        Dispatch(Handler->StartElement(Entity));
+    }
     
     static void StartElementHandler(void* userData, const XML_Char* name, const XML_Char** attrs) {
         auto Implementation = static_cast<SImplementation*>(userData);
-        SXMLEntity Entity;
-        Entity.DType = SXMLEntity::EType::StartElement;
-        Entity.DNameData = name;
+        if(Implementation->Filtering && !Implementation->FilterStartElement(name, attrs)) {
+            return;
+        }
+        if(Implementation->Handler) {
+            if(!Implementation->Stopped) {
+                Implementation->DispatchStartElement(name, attrs);
+            }
+            return;
+        }
+        Implementation->PushRecord(SXMLEntity::EType::StartElement, Implementation->Names.Intern(name), nullptr, 0);
         
         for(size_t Index = 0; attrs[Index]; Index += 2) {
-            Entity.DAttributes.emplace_back(attrs[Index], attrs[Index + 1]);
+            size_t Length = std::strlen(attrs[Index + 1]);
+            Implementation->AttributeRecords.push_back({Implementation->Names.Intern(attrs[Index]), Implementation->Arena.size(), Length});
+            Implementation->Arena.append(attrs[Index + 1], Length);
         }
-        
-        Implementation->EntityQueue.push_back(Entity);
+        Implementation->Records.back().AttributeCount = Implementation->AttributeRecords.size() - Implementation->Records.back().AttributeBegin;
     }
     
     static void EndElementHandler(void* userData, const XML_Char* name) {
         auto Implementation = static_cast<SImplementation*>(userData);
-        SXMLEntity Entity;
-        Entity.DType = SXMLEntity::EType::EndElement;
-        Entity.DNameData = name;
-        Implementation->EntityQueue.push_back(Entity);
+        if(Implementation->Filtering && !Implementation->FilterEndElement()) {
+            return;
+        }
+        if(Implementation->Handler) {
+            if(Implementation->Stopped) {
+                return;
+            }
+            SXMLEntityView Entity;
+            Entity.DType = SXMLEntity::EType::EndElement;
+            Entity.DNameAtom = Implementation->Names.Intern(name);
+            Entity.DNameData = Implementation->Names.Name(Entity.DNameAtom);
+            Entity.DAttributes = nullptr;
+            Entity.DAttributeCount = 0;
+            Implementation->Dispatch(Implementation->Handler->EndElement(Entity));
+            return;
+        }
+        Implementation->PushRecord(SXMLEntity::EType::EndElement, Implementation->Names.Intern(name), nullptr, 0);
     }
     
     static void CharDataHandler(void* userData, const XML_Char* s, int len) {
         auto Implementation = static_cast<SImplementation*>(userData);
-        std::string Data(s, len);
-        if(Data.find_first_not_of(" \t\n\r") != std::string::npos) {
-            SXMLEntity Entity;
-            Entity.DType = SXMLEntity::EType::CharData;
-            Entity.DNameData = Data;
-            Implementation->EntityQueue.push_back(Entity);
+        if(Implementation->Filtering && !Implementation->MatchDepth) {
+            return;
+        }
+        // Handlers get every chunk, whitespace only chunks can be part of
+        // longer text that Expat split up
+        if(Implementation->Handler) {
+            if(!Implementation->SkipCData && !Implementation->Stopped) {
+                Implementation->Dispatch(Implementation->Handler->CharData(std::string_view(s, len)));
+            }
+            return;
+        }
+        for(int Index = 0; Index < len; Index++) {
+            if(!std::strchr(" \t\n\r", s[Index])) {
+                Implementation->PushRecord(SXMLEntity::EType::CharData, CXMLNameTable::InvalidAtom, s, len);
+                return;
+            }
         }
     }
     
-    SImplementation(std::shared_ptr<CDataSource> src)
-        : DataSource(src), Error(false) {
+    SImplementation(std::shared_ptr<CDataSource> src, size_t chunksize, size_t maxchunksize)
+        : DataSource(src), QueueHead(0), ChunkSize(std::max<size_t>(chunksize, 1)),
+          MaxChunkSize(std::max(chunksize, maxchunksize)), Finished(false), Error(false),
+          Handler(nullptr), SkipCData(false), Stopped(false),
+          Filtering(false), MatchDepth(0), SkipDepth(0) {
         Parser = XML_ParserCreate(NULL);
         XML_SetUserData(Parser, this);
         XML_SetElementHandler(Parser, StartElementHandler, EndElementHandler);
         XML_SetCharacterDataHandler(Parser, CharDataHandler);
+        IOSTATS_ONLY(DataSource = std::make_shared<CIOStatsDataSource>(DataSource, Stats.DStats));
     }
     
     ~SImplementation() {
         XML_ParserFree(Parser);
     }
     
+    bool ParseChunk(const char* data, size_t length, bool final) {
+        IOSTATS_ONLY(Stats.DStats.DChunks++);
+        if(XML_Parse(Parser, data, length, final) != XML_STATUS_OK) {
+            Error = true;
+        }
+        Finished = final;
+        IOSTATS_ONLY(Stats.DStats.DQueueHighWater = std::max<uint64_t>(Stats.DStats.DQueueHighWater, Records.size() - QueueHead));
+        return !Error;
+    }
+    
+    // Sources that lend the next chunk are parsed in place, others are read
+    // into a buffer that is reused between calls
     bool ParseNextEntity() {
-        if(Error) {
+        if(Error || Finished) {
             return false;
         }
+        RecycleQueue();
         
-        std::vector<char> Buffer(1024);
-        bool Result = DataSource->Read(Buffer, Buffer.size());
-        if(!Result && DataSource->End()) {
-            return XML_Parse(Parser, Buffer.data(), Buffer.size(), true) == XML_STATUS_OK;
+        const char* Data;
+        size_t Length;
+        bool Full;
+        if(DataSource->Borrow(Data, Length) && 1 < Length) {
+            Length = std::min(Length, ChunkSize);
+            Full = Length == ChunkSize;
+            if(!ParseChunk(Data, Length, false)) {
+                return false;
+            }
+            DataSource->Commit(Length);
+        } else {
+            if(!DataSource->Read(Buffer, ChunkSize)) {
+                return ParseChunk(nullptr, 0, true);
+            }
+            Full = Buffer.size() == ChunkSize;
+            if(!ParseChunk(Buffer.data(), Buffer.size(), false)) {
+                return false;
+            }
+        }
+        if(Full && ChunkSize < MaxChunkSize) {
+            ChunkSize = std::min(ChunkSize * 2, MaxChunkSize);
+        }
+        if(DataSource->End()) {
+            return ParseChunk(nullptr, 0, true);
         }
-        return XML_Parse(Parser, Buffer.data(), Buffer.size(), false) == XML_STATUS_OK;
+        return true;
     }
 };
 
-CXMLReader::CXMLReader(std::shared_ptr<CDataSource> src)
-    : DImplementation(std::make_unique<SImplementation>(src)) {}
+CXMLReader::CXMLReader(std::shared_ptr<CDataSource> src, std::size_t chunksize, std::size_t maxchunksize)
+    : DImplementation(std::make_unique<SImplementation>(src, chunksize, maxchunksize)) {}
 
 CXMLReader::~CXMLReader() = default;
 
 bool CXMLReader::End() const {
-    return DImplementation->DataSource->End() && DImplementation->EntityQueue.empty();
+    IOSTATS_SCOPE(DImplementation->Stats);
+    // Nothing more is parsed after an error or a stopped Parse, whatever is
+    // left in the source
+    return DImplementation->QueueEmpty() && (DImplementation->Error || DImplementation->Finished || DImplementation->DataSource->End());
 }
 
 bool CXMLReader::ReadEntity(SXMLEntity &entity, bool skipcdata) {
-    while(DImplementation->EntityQueue.empty()) {
-        if(!DImplementation->ParseNextEntity()) {
-            return false;
+    IOSTATS_SCOPE(DImplementation->Stats);
+    SXMLEntityView View;
+    if(!ReadEntityView(View, skipcdata)) {
+        return false;
+    }
+    
+    // Assigning into the caller's strings reuses their storage
+    entity.DType = View.DType;
+    entity.DNameData.assign(View.DNameData);
+    entity.DAttributes.resize(View.DAttributeCount);
+    for(size_t Index = 0; Index < View.DAttributeCount; Index++) {
+        entity.DAttributes[Index].first.assign(View.DAttributes[Index].DName);
+        entity.DAttributes[Index].second.assign(View.DAttributes[Index].DValue);
+    }
+    return true;
+}
+
+bool CXMLReader::ReadEntityView(SXMLEntityView &entity, bool skipcdata) {
+    const SImplementation::SEntityRecord* Record;
+    IOSTATS_SCOPE(DImplementation->Stats);
+    do {
+        while(DImplementation->QueueEmpty()) {
+            IOSTATS_ONLY(size_t Capacity = DImplementation->StorageCapacity());
+            bool Parsed = DImplementation->ParseNextEntity();
+            IOSTATS_ONLY(DImplementation->Stats.DStats.DAllocations += DImplementation->StorageCapacity() != Capacity);
+            if(!Parsed && DImplementation->QueueEmpty()) {
+                return false;
+            }
+        }
+        Record = &DImplementation->PopRecord();
+    } while(skipcdata && Record->Type == SXMLEntity::EType::CharData);
+    
+    auto& Names = DImplementation->Names;
+    auto& Views = DImplementation->AttributeViews;
+    Views.clear();
+    for(size_t Index = 0; Index < Record->AttributeCount; Index++) {
+        auto& Attribute = DImplementation->AttributeRecords[Record->AttributeBegin + Index];
+        Views.push_back({Attribute.NameAtom, Names.Name(Attribute.NameAtom), DImplementation->ArenaText(Attribute.ValueOffset, Attribute.ValueLength)});
+    }
+    entity.DType = Record->Type;
+    entity.DNameAtom = Record->NameAtom;
+    entity.DNameData = Record->Type == SXMLEntity::EType::CharData ? DImplementation->ArenaText(Record->DataOffset, Record->DataLength) : Names.Name(Record->NameAtom);
+    entity.DAttributes = Views.data();
+    entity.DAttributeCount = Views.size();
+    IOSTATS_ONLY(DImplementation->Stats.DStats.DRecords++);
+    return true;
+}
+
+bool CXMLReader::Parse(CXMLHandler &handler, bool skipcdata) {
+    IOSTATS_SCOPE(DImplementation->Stats);
+    
+    // Entities already parsed into the queue are passed on first
+    SXMLEntityView Entity;
+    while(!DImplementation->QueueEmpty()) {
+        if(!ReadEntityView(Entity, skipcdata)) {
+            break;
+        }
+        bool Proceed = true;
+        switch(Entity.DType) {
+            case SXMLEntity::EType::StartElement:
+                Proceed = handler.StartElement(Entity);
+                break;
+            case SXMLEntity::EType::EndElement:
+                Proceed = handler.EndElement(Entity);
+                break;
+            default:
+                Proceed = handler.CharData(Entity.DNameData);
+                break;
         }
-        if(DImplementation->DataSource->End() && DImplementation->EntityQueue.empty()) {
+        if(!Proceed) {
+            DImplementation->RecycleQueue();
+            DImplementation->Finished = true;
             return false;
         }
     }
     
-    entity = DImplementation->EntityQueue.front();
-    DImplementation->EntityQueue.erase(DImplementation->EntityQueue.begin());
-    
-    if(skipcdata && entity.DType == SXMLEntity::EType::CharData) {
-        return ReadEntity(entity, skipcdata);
+    DImplementation->Handler = &handler;
+    DImplementation->SkipCData = skipcdata;
+    while(DImplementation->ParseNextEntity()) {
     }
-    
-    return true;
+    bool Completed = !DImplementation->Stopped && !DImplementation->Error;
+    DImplementation->Handler = nullptr;
+    DImplementation->Finished = true;
+    return Completed;
+}
+
+void CXMLReader::SetFilter(const CXMLPathFilter &filter) {
+    DImplementation->Filter = filter;
+    DImplementation->Filtering = !filter.Empty();
+    DImplementation->FilterStates = filter.FirstSteps();
+    DImplementation->FilterOffsets.assign(1, 0);
+    DImplementation->MatchDepth = 0;
+    DImplementation->SkipDepth = 0;
+}
+
+CXMLNameTable &CXMLReader::NameTable() {
+    return DImplementation->Names;
+}
+
+SIOStats CXMLReader::Stats() const {
+    return DImplementation->Stats.Snapshot();
 }
@@ -1,59 +1,140 @@
 #include "XMLWriter.h"
-#include <stack>
-#include <sstream>
+#include "TextEscaper.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const CTextEscaper XMLEscaper({{'<', "&lt;"}, {'>', "&gt;"}, {'&', "&amp;"}, {'\'', "&apos;"}, {'"', "&quot;"}});
+
+}
 
 struct CXMLWriter::SImplementation {
     std::shared_ptr<CDataSink> OutputSink;
-    std::stack<std::string> ElementStack;
+    std::vector<std::string> ElementStack;
+    // Nesting changes of the entities being written, applied to ElementStack
+    // once they are committed to the sink
+    std::vector<const std::string*> StagedStarts;
+    size_t StagedEnds = 0;
+    SIOStatsCollector Stats;
     
-    SImplementation(std::shared_ptr<CDataSink> sink) : OutputSink(sink) {}
+    SImplementation(std::shared_ptr<CDataSink> sink) : OutputSink(sink) {
+        IOSTATS_ONLY(OutputSink = std::make_shared<CIOStatsDataSink>(OutputSink, Stats.DStats));
+    }
     
-    bool WriteText(const std::string& text) {
-        for(char character : text) {
-            if(!OutputSink->Put(character)) {
-                return false;
-            }
-        }
-        return true;
+    bool WriteText(std::string_view text) {
+        return OutputSink->WriteBlock(text.data(), text.size());
     }
     
-    std::string ConvertCharData(const std::string& inputData) {
-        std::string encodedString;
-        for(char character : inputData) {
-            switch(character) {
-                case '<':
-                    encodedString += "&lt;";
-                    break;
-                case '>':
-                    encodedString += "&gt;";
-                    break;
-                case '&':
-                    encodedString += "&amp;";
-                    break;
-                case '\'':
-                    encodedString += "&apos;";
-                    break;
-                case '"':
-                    encodedString += "&quot;";
-                    break;
-                default:
-                    encodedString += character;
-            }
+    static char* Append(char* output, std::string_view text) {
+        std::memcpy(output, text.data(), text.size());
+        return output + text.size();
+    }
+    
+    static size_t AttributesLength(const std::vector<SXMLEntity::TAttribute>& attributeList) {
+        size_t length = 0;
+        for(const auto& attribute : attributeList) {
+            length += std::get<0>(attribute).size() + XMLEscaper.EscapedLength(std::get<1>(attribute)) + 4;
         }
-        return encodedString;
+        return length;
     }
     
-    bool WriteElementAttributes(const std::vector<SXMLEntity::TAttribute>& attributeList) {
+    static char* FormatAttributes(const std::vector<SXMLEntity::TAttribute>& attributeList, char* output) {
         for(const auto& attribute : attributeList) {
-            if(!WriteText(" ") ||
-               !WriteText(std::get<0>(attribute)) ||
-               !WriteText("=\"") ||
-               !WriteText(ConvertCharData(std::get<1>(attribute))) ||
-               !WriteText("\"")) {
+            *output++ = ' ';
+            output = Append(output, std::get<0>(attribute));
+            output = Append(output, "=\"");
+            output += XMLEscaper.Escape(std::get<1>(attribute), output);
+            *output++ = '"';
+        }
+        return output;
+    }
+    
+    // Returns the formatted length of the entity, or false if it cannot be
+    // written. Element nesting is staged as entities are accepted.
+    bool AcceptEntity(const SXMLEntity& entity, size_t& length) {
+        switch(entity.DType) {
+            case SXMLEntity::EType::StartElement:
+                StagedStarts.push_back(&entity.DNameData);
+                length = entity.DNameData.size() + AttributesLength(entity.DAttributes) + 2;
+                return true;
+            case SXMLEntity::EType::EndElement:
+                if(!StagedStarts.empty()) {
+                    if(*StagedStarts.back() != entity.DNameData) {
+                        return false;
+                    }
+                    StagedStarts.pop_back();
+                } else {
+                    if(StagedEnds == ElementStack.size() || ElementStack[ElementStack.size() - 1 - StagedEnds] != entity.DNameData) {
+                        return false;
+                    }
+                    StagedEnds++;
+                }
+                length = entity.DNameData.size() + 3;
+                return true;
+            case SXMLEntity::EType::CharData:
+                length = XMLEscaper.EscapedLength(entity.DNameData);
+                return true;
+            case SXMLEntity::EType::CompleteElement:
+                length = entity.DNameData.size() + AttributesLength(entity.DAttributes) + 3;
+                return true;
+        }
+        return false;
+    }
+    
+    static char* FormatEntity(const SXMLEntity& entity, char* output) {
+        switch(entity.DType) {
+            case SXMLEntity::EType::StartElement:
+            case SXMLEntity::EType::CompleteElement:
+                *output++ = '<';
+                output = Append(output, entity.DNameData);
+                output = FormatAttributes(entity.DAttributes, output);
+                return Append(output, entity.DType == SXMLEntity::EType::StartElement ? ">" : "/>");
+            case SXMLEntity::EType::EndElement:
+                output = Append(output, "</");
+                output = Append(output, entity.DNameData);
+                *output++ = '>';
+                return output;
+            case SXMLEntity::EType::CharData:
+                return output + XMLEscaper.Escape(entity.DNameData, output);
+        }
+        return output;
+    }
+    
+    // Accepted entities up to the first invalid one are formatted into a
+    // single sink reservation
+    bool WriteEntities(const SXMLEntity* entities, size_t count) {
+        size_t length = 0;
+        size_t accepted = 0;
+        size_t entityLength;
+        IOSTATS_SCOPE(Stats);
+        StagedStarts.clear();
+        StagedEnds = 0;
+        while(accepted < count && AcceptEntity(entities[accepted], entityLength)) {
+            length += entityLength;
+            accepted++;
+        }
+        IOSTATS_ONLY(Stats.DStats.DRecords += accepted);
+        
+        if(length) {
+            char* buffer = OutputSink->Reserve(length);
+            if(!buffer) {
+                return false;
+            }
+            char* output = buffer;
+            for(size_t index = 0; index < accepted; index++) {
+                output = FormatEntity(entities[index], output);
+            }
+            if(!OutputSink->Commit(output - buffer)) {
                 return false;
             }
         }
-        return true;
+        ElementStack.resize(ElementStack.size() - StagedEnds);
+        for(auto name : StagedStarts) {
+            ElementStack.push_back(*name);
+            IOSTATS_ONLY(Stats.DStats.DAllocations += ElementStack.back().capacity() > std::string().capacity());
+        }
+        return accepted == count;
     }
 };
 
@@ -64,53 +145,26 @@ CXMLWriter::CXMLWriter(std::shared_ptr<CDataSink> sink)
 CXMLWriter::~CXMLWriter() = default;
 
 bool CXMLWriter::Flush() {
+    IOSTATS_SCOPE(DImplementation->Stats);
     while(!DImplementation->ElementStack.empty()) {
         if(!DImplementation->WriteText("</") ||
-           !DImplementation->WriteText(DImplementation->ElementStack.top()) ||
+           !DImplementation->WriteText(DImplementation->ElementStack.back()) ||
            !DImplementation->WriteText(">")) {
             return false;
         }
-        DImplementation->ElementStack.pop();
+        DImplementation->ElementStack.pop_back();
     }
     return true;
 }
 
 bool CXMLWriter::WriteEntity(const SXMLEntity& entity) {
-    switch(entity.DType) {
-        case SXMLEntity::EType::StartElement:
-            if(!DImplementation->WriteText("<") ||
-               !DImplementation->WriteText(entity.DNameData) ||
-               !DImplementation->WriteElementAttributes(entity.DAttributes) ||
-               !DImplementation->WriteText(">")) {
-                return false;
-            }
-            DImplementation->ElementStack.push(entity.DNameData);
-            return true;
-            
-        case SXMLEntity::EType::EndElement:
-            if(DImplementation->ElementStack.empty() ||
-               DImplementation->ElementStack.top() != entity.DNameData) {
-                return false;
-            }
-            if(!DImplementation->WriteText("</") ||
-               !DImplementation->WriteText(entity.DNameData) ||
-               !DImplementation->WriteText(">")) {
-                return false;
-            }
-            DImplementation->ElementStack.pop();
-            return true;
-            
-        case SXMLEntity::EType::CharData:
-            return DImplementation->WriteText(DImplementation->ConvertCharData(entity.DNameData));
-            
-        case SXMLEntity::EType::CompleteElement:
-            if(!DImplementation->WriteText("<") ||
-               !DImplementation->WriteText(entity.DNameData) ||
-               !DImplementation->WriteElementAttributes(entity.DAttributes) ||
-               !DImplementation->WriteText("/>")) {
-                return false;
-            }
-            return true;
-    }
-    return false;
+    return DImplementation->WriteEntities(&entity, 1);
+}
+
+bool CXMLWriter::WriteEntities(const std::vector<SXMLEntity>& entities) {
+    return DImplementation->WriteEntities(entities.data(), entities.size());
+}
+
+SIOStats CXMLWriter::Stats() const {
+    return DImplementation->Stats.Snapshot();
 }
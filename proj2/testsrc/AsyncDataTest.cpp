@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "AsyncDataSource.h"
+#include "AsyncDataSink.h"
+#include "StringDataSource.h"
+#include "StringDataSink.h"
+#include "DSVReader.h"
+#include "DSVWriter.h"
+
+static std::string GenerateRows(int count){
+    std::string Contents;
+    for(int Index = 0; Index < count; Index++){
+        Contents += std::to_string(Index) + ",\"quoted, " + std::to_string(Index * 7) + "\",last\n";
+    }
+    return Contents;
+}
+
+TEST(AsyncDataSource, GetPeekTest){
+    auto Source = std::make_shared<CAsyncDataSource>(std::make_shared<CStringDataSource>("Hello"), 2);
+    char ch = 0;
+    std::vector<char> Buffer;
+
+    EXPECT_FALSE(Source->End());
+    EXPECT_TRUE(Source->Peek(ch));
+    EXPECT_EQ(ch, 'H');
+    EXPECT_TRUE(Source->Get(ch));
+    EXPECT_EQ(ch, 'H');
+    EXPECT_TRUE(Source->Read(Buffer, 3));
+    EXPECT_EQ(std::string(Buffer.begin(), Buffer.end()), "ell");
+    EXPECT_TRUE(Source->Get(ch));
+    EXPECT_EQ(ch, 'o');
+    EXPECT_TRUE(Source->End());
+    EXPECT_FALSE(Source->Get(ch));
+    EXPECT_FALSE(Source->Peek(ch));
+}
+
+TEST(AsyncDataSource, EmptyTest){
+    CAsyncDataSource Source(std::make_shared<CStringDataSource>(""));
+    const char *Data;
+    std::size_t Length;
+
+    EXPECT_TRUE(Source.End());
+    EXPECT_FALSE(Source.Borrow(Data, Length));
+}
+
+TEST(AsyncDataSource, DSVReaderTest){
+    std::string Contents = GenerateRows(2000);
+    auto Source = std::make_shared<CAsyncDataSource>(std::make_shared<CStringDataSource>(Contents), 100);
+    CDSVReader Reader(Source, ',');
+    std::vector<std::string> Row;
+    int Count = 0;
+
+    while(Reader.ReadRow(Row)){
+        ASSERT_EQ(Row.size(), 3);
+        EXPECT_EQ(Row[0], std::to_string(Count));
+        EXPECT_EQ(Row[1], "quoted, " + std::to_string(Count * 7));
+        Count++;
+    }
+    EXPECT_EQ(Count, 2000);
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(AsyncDataSink, WriteFlushTest){
+    auto Sink = std::make_shared<CStringDataSink>();
+    std::string Expected;
+    {
+        CAsyncDataSink AsyncSink(Sink, 16);
+        for(int Index = 0; Index < 100; Index++){
+            std::string Text = std::to_string(Index) + ";";
+            EXPECT_TRUE(AsyncSink.Write(std::vector<char>(Text.begin(), Text.end())));
+            EXPECT_TRUE(AsyncSink.Put('.'));
+            EXPECT_TRUE(AsyncSink.WriteBlock("abcdefghijklmnopqrstuvwxyz", 26));
+            Expected += Text + ".abcdefghijklmnopqrstuvwxyz";
+        }
+        EXPECT_TRUE(AsyncSink.Flush());
+        EXPECT_EQ(Sink->String(), Expected);
+        EXPECT_TRUE(AsyncSink.Put('!'));
+    }
+    EXPECT_EQ(Sink->String(), Expected + "!");
+}
+
+TEST(AsyncDataSink, CommitWithoutReserveTest){
+    auto Sink = std::make_shared<CStringDataSink>();
+    {
+        CAsyncDataSink AsyncSink(Sink, 16);
+        EXPECT_FALSE(AsyncSink.Commit(0));
+        EXPECT_TRUE(AsyncSink.WriteBlock("abc", 3));
+        EXPECT_FALSE(AsyncSink.Commit(0));
+        ASSERT_NE(AsyncSink.Reserve(4), nullptr);
+        EXPECT_TRUE(AsyncSink.Put('d'));
+        EXPECT_FALSE(AsyncSink.Commit(2));
+        ASSERT_NE(AsyncSink.Reserve(4), nullptr);
+    }
+    EXPECT_EQ(Sink->String(), "abcd");
+}
+
+TEST(AsyncDataSink, DSVWriterTest){
+    auto Sink = std::make_shared<CStringDataSink>();
+    auto AsyncSink = std::make_shared<CAsyncDataSink>(Sink, 64);
+    CDSVWriter Writer(AsyncSink, ',');
+
+    for(int Index = 0; Index < 2000; Index++){
+        EXPECT_TRUE(Writer.WriteRow({std::to_string(Index), "quoted, " + std::to_string(Index * 7), "last"}));
+    }
+    EXPECT_TRUE(AsyncSink->Flush());
+    std::string Expected = GenerateRows(2000);
+    EXPECT_EQ(Sink->String(), Expected);
+}
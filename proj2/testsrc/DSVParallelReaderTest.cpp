@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "DSVParallelReader.h"
+#include "DSVReader.h"
+#include "StringDataSource.h"
+
+static std::string GenerateInput(size_t rows){
+    std::string Input;
+    for(size_t Index = 0; Index < rows; Index++){
+        switch(Index % 5){
+            case 0: Input += "plain," + std::to_string(Index) + ",text\n"; break;
+            case 1: Input += "\"quoted, with\ncomma\"," + std::to_string(Index) + "\r\n"; break;
+            case 2: Input += "\"esc\"\"aped\",,\n\n"; break;
+            case 3: Input += std::string(90, 'w') + "," + std::to_string(Index) + "\n"; break;
+            default: Input += "\"" + std::string(150, ',') + "\"\n"; break;
+        }
+    }
+    return Input + "tail,row";
+}
+
+static std::vector< std::vector<std::string> > ReadAllSequential(const std::string &input){
+    CDSVReader Reader(std::make_shared<CStringDataSource>(input), ',');
+    std::vector< std::vector<std::string> > Rows;
+    std::vector<std::string> Row;
+    while(Reader.ReadRow(Row)){
+        Rows.push_back(Row);
+    }
+    return Rows;
+}
+
+TEST(DSVParallelReader, MatchesSequentialTest){
+    std::string Input = GenerateInput(500);
+    auto Expected = ReadAllSequential(Input);
+
+    for(size_t ChunkSize : {64, 100, 4096}){
+        CDSVParallelReader Reader(std::make_shared<CStringDataSource>(Input), ',', 4, ChunkSize);
+        std::vector< std::vector<std::string> > Rows;
+        std::vector<std::string> Row;
+        while(!Reader.End()){
+            ASSERT_TRUE(Reader.ReadRow(Row));
+            Rows.push_back(Row);
+        }
+        EXPECT_FALSE(Reader.ReadRow(Row));
+        EXPECT_EQ(Rows, Expected);
+    }
+}
+
+TEST(DSVParallelReader, LeadingNewlineTest){
+    CDSVParallelReader Reader(std::make_shared<CStringDataSource>("\na,b\n"), ',', 2, 64);
+    std::vector<std::string> Row;
+
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_TRUE(Row.empty());
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"a", "b"}));
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(DSVParallelReader, LongRowTest){
+    std::string Long = std::string(300, 'x');
+    CDSVParallelReader Reader(std::make_shared<CStringDataSource>(Long + "," + Long + "\nend\n"), ',', 2, 64);
+    std::vector<std::string> Row;
+
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({Long, Long}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"end"}));
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(DSVParallelReader, EndTest){
+    CDSVParallelReader Reader(std::make_shared<CStringDataSource>("\n\na,b\nc\n\n\n"), ',', 2, 64);
+    std::vector<std::string> Row;
+
+    // Asking does not consume the leading blank lines
+    EXPECT_FALSE(Reader.End());
+    EXPECT_FALSE(Reader.End());
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_TRUE(Row.empty());
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"a", "b"}));
+    EXPECT_FALSE(Reader.End());
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"c"}));
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadRow(Row));
+}
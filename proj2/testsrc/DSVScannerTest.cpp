@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "DSVScanner.h"
+#include <string>
+
+TEST(DSVScanner, FindSpecialTest) {
+    std::string Data(100, 'a');
+    
+    EXPECT_EQ(DSVScanner::FindSpecial(Data.data(), Data.size(), ','), 100);
+    EXPECT_EQ(DSVScanner::FindSpecial(Data.data(), 0, ','), 0);
+    Data[77] = '\r';
+    Data[90] = ',';
+    EXPECT_EQ(DSVScanner::FindSpecial(Data.data(), Data.size(), ','), 77);
+    Data[40] = '"';
+    EXPECT_EQ(DSVScanner::FindSpecial(Data.data(), Data.size(), ','), 40);
+    Data[3] = '\t';
+    EXPECT_EQ(DSVScanner::FindSpecial(Data.data(), Data.size(), '\t'), 3);
+}
+
+TEST(DSVScanner, FindQuoteTest) {
+    std::string Data(70, ',');
+    
+    EXPECT_EQ(DSVScanner::FindQuote(Data.data(), Data.size()), 70);
+    Data[65] = '"';
+    EXPECT_EQ(DSVScanner::FindQuote(Data.data(), Data.size()), 65);
+    EXPECT_EQ(DSVScanner::CountQuotes(Data.data(), Data.size()), 1);
+}
+
+TEST(DSVScanner, StructuralMaskTest) {
+    std::string Block(64, 'a');
+    Block[1] = ',';
+    Block[3] = '"';
+    Block[5] = ',';
+    Block[7] = '"';
+    Block[9] = '\n';
+    Block[60] = '"';
+    Block[62] = ',';
+    uint64_t InQuote = 0;
+    
+    uint64_t Mask = DSVScanner::StructuralMask(Block.data(), ',', InQuote);
+    EXPECT_EQ(Mask, (uint64_t(1) << 1) | (uint64_t(1) << 9));
+    EXPECT_EQ(InQuote, ~uint64_t(0));
+    
+    Block = std::string(64, 'b');
+    Block[0] = ',';
+    Block[2] = '"';
+    Block[4] = '\r';
+    Mask = DSVScanner::StructuralMask(Block.data(), ',', InQuote);
+    EXPECT_EQ(Mask, uint64_t(1) << 4);
+    EXPECT_EQ(InQuote, 0);
+}
@@ -78,4 +78,273 @@ TEST(DSVReader, EmptyLineTest) {
     EXPECT_TRUE(Reader.ReadRow(Row));
     EXPECT_TRUE(Row.empty());
     EXPECT_TRUE(Reader.End());
-}
\ No newline at end of file
+}
+
+TEST(DSVReader, MultipleRowsTest) {
+    auto Source = std::make_shared<CStringDataSource>("a,b\r\nc,d\n\ne\n");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string> Row;
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"a", "b"}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"c", "d"}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"e"}));
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadRow(Row));
+}
+
+TEST(DSVReader, TrailingDelimiterTest) {
+    auto Source = std::make_shared<CStringDataSource>("a,\n b ,");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string> Row;
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"a", ""}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"b ", ""}));
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(DSVReader, LongFieldTest) {
+    std::string Plain(100, 'x');
+    std::string Quoted = std::string(70, 'y') + "\"\"" + std::string(40, 'z');
+    auto Source = std::make_shared<CStringDataSource>(Plain + "|\"" + Quoted + "\"|" + Plain + "\n");
+    CDSVReader Reader(Source, '|');
+    
+    std::vector<std::string> Row;
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    ASSERT_EQ(Row.size(), 3);
+    EXPECT_EQ(Row[0], Plain);
+    EXPECT_EQ(Row[1], std::string(70, 'y') + "\"" + std::string(40, 'z'));
+    EXPECT_EQ(Row[2], Plain);
+    EXPECT_TRUE(Reader.End());
+}
+
+// Only exposes one character per Borrow so every window boundary is exercised
+class CCharDataSource : public CDataSource {
+    private:
+        CStringDataSource DSource;
+    public:
+        CCharDataSource(const std::string &str) : DSource(str) {}
+        bool End() const noexcept override { return DSource.End(); }
+        bool Get(char &ch) noexcept override { return DSource.Get(ch); }
+        bool Peek(char &ch) noexcept override { return DSource.Peek(ch); }
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override { return DSource.Read(buf, count); }
+};
+
+TEST(DSVReader, SmallWindowTest) {
+    auto Source = std::make_shared<CCharDataSource>("\"a\"\"b\",  \"c,d\"e\n\"\"\"\"\n");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string> Row;
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"a\"b", "c,de"}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"\""}));
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(DSVReader, RowViewTest) {
+    std::string Input = "a, \"b,c\",\"d\"\"e\"f\n\n\"g\"\r\nlast,";
+    auto Source = std::make_shared<CStringDataSource>(Input);
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string_view> Row;
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 3);
+    EXPECT_EQ(Row[0], "a");
+    EXPECT_EQ(Row[1], "b,c");
+    EXPECT_EQ(Row[2], "d\"ef");
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 1);
+    EXPECT_EQ(Row[0], "g");
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 2);
+    EXPECT_EQ(Row[0], "last");
+    EXPECT_EQ(Row[1], "");
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadRowView(Row));
+}
+
+TEST(DSVReader, RowViewWindowTest) {
+    auto Source = std::make_shared<CCharDataSource>("\n\"a\"\"b\",c\nd\n");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string_view> Row;
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    EXPECT_TRUE(Row.empty());
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 2);
+    EXPECT_EQ(Row[0], "a\"b");
+    EXPECT_EQ(Row[1], "c");
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 1);
+    EXPECT_EQ(Row[0], "d");
+    EXPECT_TRUE(Reader.End());
+}
+
+// Reuses one small window and overwrites it on every Commit, like a source
+// that refills a single buffer
+class CRefillingDataSource : public CDataSource {
+    private:
+        std::string DData;
+        std::size_t DPosition = 0;
+        char DWindow[8];
+    public:
+        CRefillingDataSource(const std::string &str) : DData(str) {}
+        bool End() const noexcept override { return DPosition >= DData.size(); }
+        bool Get(char &ch) noexcept override { return Peek(ch) && ++DPosition; }
+        bool Peek(char &ch) noexcept override {
+            if (End()) {
+                return false;
+            }
+            ch = DData[DPosition];
+            return true;
+        }
+        bool Read(std::vector<char> &buf, std::size_t count) noexcept override {
+            count = std::min(count, DData.size() - DPosition);
+            buf.assign(DData.begin() + DPosition, DData.begin() + DPosition + count);
+            DPosition += count;
+            return count > 0;
+        }
+        bool Borrow(const char *&data, std::size_t &length) noexcept override {
+            length = std::min(sizeof(DWindow), DData.size() - DPosition);
+            std::copy_n(DData.data() + DPosition, length, DWindow);
+            data = DWindow;
+            return length > 0;
+        }
+        bool Commit(std::size_t count) noexcept override {
+            DPosition += std::min(count, DData.size() - DPosition);
+            std::fill_n(DWindow, sizeof(DWindow), '#');
+            return true;
+        }
+};
+
+TEST(DSVReader, RowViewEndTest) {
+    auto Source = std::make_shared<CRefillingDataSource>("ab,cd\nef\n\n");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string_view> Row;
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    EXPECT_FALSE(Reader.End());
+    ASSERT_EQ(Row.size(), 2);
+    EXPECT_EQ(Row[0], "ab");
+    EXPECT_EQ(Row[1], "cd");
+    EXPECT_TRUE(Reader.ReadRowView(Row));
+    ASSERT_EQ(Row.size(), 1);
+    EXPECT_EQ(Row[0], "ef");
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadRowView(Row));
+}
+
+TEST(DSVReader, RefillingWindowTest) {
+    // Terminators fall at the end of the window, where they are overwritten
+    // once the window is committed
+    auto Source = std::make_shared<CRefillingDataSource>("abcdefg,hijklmn\nop,\"q\"\"r\"\n");
+    CDSVReader Reader(Source, ',');
+    
+    std::vector<std::string> Row;
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"abcdefg", "hijklmn"}));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_EQ(Row, std::vector<std::string>({"op", "q\"r"}));
+    EXPECT_TRUE(Reader.End());
+}
+
+TEST(DSVReader, ReadBatchTest) {
+    auto Source = std::make_shared<CStringDataSource>("a,1,2.5\n\"b,c\",x,-3\nd\ne,7,8,extra\n");
+    CDSVReader Reader(Source, ',');
+    
+    SDSVColumnBatch Batch;
+    Batch.DColumns.resize(3);
+    Batch.DColumns[1].DType = SDSVColumn::EType::Int64;
+    Batch.DColumns[2].DType = SDSVColumn::EType::Double;
+    EXPECT_EQ(Reader.ReadBatch(Batch, 3), 3);
+    ASSERT_EQ(Batch.DColumns.size(), 3);
+    EXPECT_EQ(Batch.DColumns[0].StringValue(0), "a");
+    EXPECT_EQ(Batch.DColumns[0].StringValue(1), "b,c");
+    EXPECT_EQ(Batch.DColumns[0].StringValue(2), "d");
+    EXPECT_TRUE(Batch.DColumns[1].Valid(0));
+    EXPECT_EQ(Batch.DColumns[1].DInt64Values[0], 1);
+    EXPECT_FALSE(Batch.DColumns[1].Valid(1));
+    EXPECT_FALSE(Batch.DColumns[1].Valid(2));
+    EXPECT_DOUBLE_EQ(Batch.DColumns[2].DDoubleValues[0], 2.5);
+    EXPECT_DOUBLE_EQ(Batch.DColumns[2].DDoubleValues[1], -3.0);
+    
+    EXPECT_EQ(Reader.ReadBatch(Batch, 3), 1);
+    ASSERT_EQ(Batch.DColumns.size(), 4);
+    EXPECT_EQ(Batch.DColumns[0].StringValue(0), "e");
+    EXPECT_EQ(Batch.DColumns[1].DInt64Values[0], 7);
+    EXPECT_EQ(Batch.DColumns[3].StringValue(0), "extra");
+    EXPECT_TRUE(Reader.End());
+    EXPECT_EQ(Reader.ReadBatch(Batch, 3), 0);
+}
+
+TEST(DSVWriter, QuoteAllTest) {
+    auto Sink = std::make_shared<CStringDataSink>();
+    CDSVWriter Writer(Sink, '\t', true);
+    
+    std::vector<std::string> Row = {"a", "", "b\"c"};
+    EXPECT_TRUE(Writer.WriteRow(Row));
+    EXPECT_EQ(Sink->String(), "\"a\"\t\"\"\t\"b\"\"c\"\n");
+}
+
+TEST(DSVWriter, WriteRowsTest) {
+    auto Sink = std::make_shared<CStringDataSink>();
+    CDSVWriter Writer(Sink, ',');
+    
+    std::vector<std::vector<std::string>> Rows = {{"a", "b,c"}, {}, {"\"q\"", "", "d"}};
+    std::string Expected = "a,\"b,c\"\n\n\"\"\"q\"\"\",,d\n";
+    EXPECT_TRUE(Writer.WriteRows(Rows));
+    EXPECT_EQ(Sink->String(), Expected);
+    EXPECT_TRUE(Writer.WriteRows({}));
+    EXPECT_EQ(Sink->String(), Expected);
+    
+    std::string Buffer = "header\n";
+    EXPECT_EQ(Writer.FormatRows(Rows, Buffer), Expected.size());
+    EXPECT_EQ(Buffer, "header\n" + Expected);
+}
+
+TEST(DSVReader, StatsTest) {
+    std::string Input = "a,b,c\n1,2,3\n\"x\",\"y,z\",w\n";
+    CDSVReader Reader(std::make_shared<CStringDataSource>(Input), ',');
+    std::vector<std::string> Row;
+    std::vector<std::string_view> RowView;
+    
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_TRUE(Reader.ReadRowView(RowView));
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    EXPECT_FALSE(Reader.ReadRow(Row));
+    
+    auto Stats = Reader.Stats();
+    if (SIOStats::Enabled) {
+        EXPECT_EQ(Stats.DRecords, 3);
+        EXPECT_EQ(Stats.DBytes, Input.size());
+        EXPECT_GT(Stats.DCalls, 0);
+        EXPECT_GT(Stats.DAllocations, 0);
+        EXPECT_GT(Stats.DIOCycles, 0);
+    } else {
+        EXPECT_EQ(Stats.DRecords, 0);
+        EXPECT_EQ(Stats.DBytes, 0);
+    }
+}
+
+TEST(DSVWriter, StatsTest) {
+    auto Sink = std::make_shared<CStringDataSink>();
+    CDSVWriter Writer(Sink, ',');
+    
+    EXPECT_TRUE(Writer.WriteRow({"a", "b,c"}));
+    EXPECT_TRUE(Writer.WriteRows({{"1"}, {"2"}}));
+    
+    auto Stats = Writer.Stats();
+    if (SIOStats::Enabled) {
+        EXPECT_EQ(Stats.DRecords, 3);
+        EXPECT_EQ(Stats.DBytes, Sink->String().size());
+        EXPECT_EQ(Stats.DCalls, 4);
+    } else {
+        EXPECT_EQ(Stats.DRecords, 0);
+        EXPECT_EQ(Stats.DBytes, 0);
+    }
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "DSVTypedReader.h"
+#include "StringDataSource.h"
+
+TEST(DSVConvert, NumberTest){
+    int64_t IntValue = 0;
+    double DoubleValue = 0.0;
+
+    EXPECT_EQ(DSVConvert::ParseInt64("-42", IntValue), DSVConvert::EResult::Ok);
+    EXPECT_EQ(IntValue, -42);
+    EXPECT_EQ(DSVConvert::ParseInt64("+7", IntValue), DSVConvert::EResult::Ok);
+    EXPECT_EQ(IntValue, 7);
+    EXPECT_EQ(DSVConvert::ParseInt64("", IntValue), DSVConvert::EResult::Empty);
+    EXPECT_EQ(DSVConvert::ParseInt64("12a", IntValue), DSVConvert::EResult::Invalid);
+    EXPECT_EQ(DSVConvert::ParseInt64("+-1", IntValue), DSVConvert::EResult::Invalid);
+    EXPECT_EQ(DSVConvert::ParseInt64("99999999999999999999", IntValue), DSVConvert::EResult::OutOfRange);
+    EXPECT_EQ(DSVConvert::ParseDouble("1.5e3", DoubleValue), DSVConvert::EResult::Ok);
+    EXPECT_DOUBLE_EQ(DoubleValue, 1500.0);
+    EXPECT_EQ(DSVConvert::ParseDouble("1.5.2", DoubleValue), DSVConvert::EResult::Invalid);
+}
+
+TEST(DSVConvert, BoolDateTest){
+    bool BoolValue = false;
+    int64_t Days = 0;
+
+    EXPECT_EQ(DSVConvert::ParseBool("TRUE", BoolValue), DSVConvert::EResult::Ok);
+    EXPECT_TRUE(BoolValue);
+    EXPECT_EQ(DSVConvert::ParseBool("0", BoolValue), DSVConvert::EResult::Ok);
+    EXPECT_FALSE(BoolValue);
+    EXPECT_EQ(DSVConvert::ParseBool("maybe", BoolValue), DSVConvert::EResult::Invalid);
+    EXPECT_EQ(DSVConvert::ParseDate("1970-01-01", Days), DSVConvert::EResult::Ok);
+    EXPECT_EQ(Days, 0);
+    EXPECT_EQ(DSVConvert::ParseDate("2000-03-01", Days), DSVConvert::EResult::Ok);
+    EXPECT_EQ(Days, 11017);
+    EXPECT_EQ(DSVConvert::ParseDate("1969-12-31", Days), DSVConvert::EResult::Ok);
+    EXPECT_EQ(Days, -1);
+    EXPECT_EQ(DSVConvert::ParseDate("2023-02-29", Days), DSVConvert::EResult::OutOfRange);
+    EXPECT_EQ(DSVConvert::ParseDate("2023/02/01", Days), DSVConvert::EResult::Invalid);
+}
+
+TEST(DSVTypedReader, ReadRowTest){
+    auto Source = std::make_shared<CStringDataSource>("name,1,2.5,true,2024-02-29\n\"x\",abc,,no\n");
+    CDSVTypedReader Reader(Source, ',', {SDSVTypedField::EType::String, SDSVTypedField::EType::Int,
+        SDSVTypedField::EType::Double, SDSVTypedField::EType::Bool, SDSVTypedField::EType::Date});
+    std::vector<SDSVTypedField> Row;
+
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    ASSERT_EQ(Row.size(), 5);
+    EXPECT_EQ(Reader.ErrorCount(), 0);
+    EXPECT_EQ(Row[0].DString, "name");
+    EXPECT_EQ(Row[1].DInt, 1);
+    EXPECT_DOUBLE_EQ(Row[2].DDouble, 2.5);
+    EXPECT_TRUE(Row[3].DBool);
+    EXPECT_EQ(Row[4].DInt, 19782);
+
+    EXPECT_TRUE(Reader.ReadRow(Row));
+    ASSERT_EQ(Row.size(), 5);
+    EXPECT_EQ(Reader.ErrorCount(), 4);
+    EXPECT_TRUE(Row[0].Valid());
+    EXPECT_EQ(Row[1].DResult, DSVConvert::EResult::Invalid);
+    EXPECT_EQ(Row[1].DString, "abc");
+    EXPECT_EQ(Row[2].DResult, DSVConvert::EResult::Empty);
+    EXPECT_EQ(Row[3].DResult, DSVConvert::EResult::Invalid);
+    EXPECT_EQ(Row[4].DResult, DSVConvert::EResult::Empty);
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadRow(Row));
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "FileDataSink.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static std::string CreateTempPath(){
+    char Path[] = "/tmp/filesinkXXXXXX";
+    int FileDescriptor = mkstemp(Path);
+    if(0 <= FileDescriptor){
+        close(FileDescriptor);
+    }
+    return Path;
+}
+
+static std::string ReadFile(const std::string &path){
+    std::string Contents;
+    char Buffer[256];
+    int FileDescriptor = open(path.c_str(), O_RDONLY);
+    ssize_t Length;
+    while(0 < (Length = read(FileDescriptor, Buffer, sizeof(Buffer)))){
+        Contents.append(Buffer, Length);
+    }
+    close(FileDescriptor);
+    return Contents;
+}
+
+TEST(FileDataSink, InvalidTest){
+    CFileDataSink Sink("/nonexistent/dir/out.csv");
+
+    EXPECT_FALSE(Sink.IsOpen());
+    EXPECT_FALSE(Sink.Put('x'));
+    EXPECT_FALSE(Sink.Flush());
+}
+
+TEST(FileDataSink, PutFlushTest){
+    std::string Path = CreateTempPath();
+    CFileDataSink Sink(Path);
+
+    EXPECT_TRUE(Sink.Put('H'));
+    EXPECT_TRUE(Sink.Put('i'));
+    EXPECT_EQ(ReadFile(Path),"");
+    EXPECT_TRUE(Sink.Flush());
+    EXPECT_EQ(ReadFile(Path),"Hi");
+    EXPECT_TRUE(Sink.Close());
+    EXPECT_FALSE(Sink.Put('!'));
+    unlink(Path.c_str());
+}
+
+TEST(FileDataSink, CoalesceTest){
+    std::string Path = CreateTempPath();
+    std::vector<char> Large(10, 'b');
+    {
+        CFileDataSink Sink(Path, false, 4);
+
+        EXPECT_TRUE(Sink.Put('a'));
+        EXPECT_TRUE(Sink.Write(Large));
+        EXPECT_EQ(ReadFile(Path),"abbbbbbbbbb");
+        char *Buffer = Sink.Reserve(6);
+        ASSERT_NE(Buffer,nullptr);
+        std::memcpy(Buffer, "cccccc", 6);
+        EXPECT_TRUE(Sink.Commit(6));
+        EXPECT_TRUE(Sink.Put('d'));
+    }
+    EXPECT_EQ(ReadFile(Path),"abbbbbbbbbbccccccd");
+    unlink(Path.c_str());
+}
+
+TEST(FileDataSink, AppendTest){
+    std::string Path = CreateTempPath();
+    {
+        CFileDataSink Sink(Path);
+        EXPECT_TRUE(Sink.Write({'a','b'}));
+    }
+    {
+        CFileDataSink Sink(Path, true);
+        EXPECT_TRUE(Sink.Write({'c','d'}));
+    }
+    EXPECT_EQ(ReadFile(Path),"abcd");
+    unlink(Path.c_str());
+}
+
+TEST(FileDataSink, LargeReserveTest){
+    std::string Path = CreateTempPath();
+    {
+        CFileDataSink Sink(Path, false, 4);
+
+        EXPECT_TRUE(Sink.Put('a'));
+        char *Buffer = Sink.Reserve(10);
+        ASSERT_NE(Buffer,nullptr);
+        std::memcpy(Buffer, "bbbbbbbbbb", 10);
+        EXPECT_EQ(ReadFile(Path),"");
+        EXPECT_TRUE(Sink.Commit(8));
+        EXPECT_EQ(ReadFile(Path),"abbbbbbbb");
+        // The buffer keeps its size, so small writes are buffered again
+        Buffer = Sink.Reserve(3);
+        ASSERT_NE(Buffer,nullptr);
+        std::memcpy(Buffer, "ccc", 3);
+        EXPECT_TRUE(Sink.Commit(3));
+        EXPECT_TRUE(Sink.Put('d'));
+        EXPECT_EQ(ReadFile(Path),"abbbbbbbb");
+    }
+    EXPECT_EQ(ReadFile(Path),"abbbbbbbbcccd");
+    unlink(Path.c_str());
+}
+
+TEST(FileDataSink, CommitWithoutReserveTest){
+    std::string Path = CreateTempPath();
+    {
+        CFileDataSink Sink(Path, false, 16);
+
+        EXPECT_FALSE(Sink.Commit(0));
+        EXPECT_TRUE(Sink.Write({'a','b','c'}));
+        EXPECT_FALSE(Sink.Commit(2));
+        ASSERT_NE(Sink.Reserve(4),nullptr);
+        EXPECT_TRUE(Sink.Put('d'));
+        EXPECT_FALSE(Sink.Commit(2));
+        ASSERT_NE(Sink.Reserve(32),nullptr);
+        EXPECT_TRUE(Sink.Flush());
+        EXPECT_FALSE(Sink.Commit(2));
+    }
+    EXPECT_EQ(ReadFile(Path),"abcd");
+    unlink(Path.c_str());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "GzipDataSource.h"
+#include "GzipDataSink.h"
+#include "StringDataSource.h"
+#include "StringDataSink.h"
+#include "DSVReader.h"
+#include "DSVWriter.h"
+
+static std::string GenerateText(int count){
+    std::string Contents;
+    for(int Index = 0; Index < count; Index++){
+        Contents += std::to_string(Index * 7919 % 1000) + ",row " + std::to_string(Index) + "\n";
+    }
+    return Contents;
+}
+
+static std::string Compress(const std::string &text, std::size_t threads, std::size_t blocksize){
+    auto Sink = std::make_shared<CStringDataSink>();
+    CGzipDataSink GzipSink(Sink, CGzipDataSink::DefaultLevel, threads, blocksize);
+    EXPECT_TRUE(GzipSink.Write(std::vector<char>(text.begin(), text.end())));
+    EXPECT_TRUE(GzipSink.Close());
+    return Sink->String();
+}
+
+static std::string Decompress(const std::string &data, std::size_t buffersize){
+    CGzipDataSource Source(std::make_shared<CStringDataSource>(data), buffersize);
+    std::vector<char> Buffer;
+    std::string Result;
+    while(Source.Read(Buffer, 1000)){
+        Result.append(Buffer.begin(), Buffer.end());
+    }
+    EXPECT_FALSE(Source.HasError());
+    return Result;
+}
+
+TEST(GzipDataSink, RoundTripTest){
+    std::string Text = GenerateText(20000);
+    std::string Compressed = Compress(Text, 1, 4096);
+
+    EXPECT_LT(Compressed.size(), Text.size() / 2);
+    EXPECT_EQ(static_cast<unsigned char>(Compressed[0]), 0x1F);
+    EXPECT_EQ(static_cast<unsigned char>(Compressed[1]), 0x8B);
+    EXPECT_EQ(Decompress(Compressed, 100), Text);
+    EXPECT_EQ(Decompress(Compress("", 1, 4096), 100), "");
+}
+
+TEST(GzipDataSink, ThreadedTest){
+    std::string Text = GenerateText(20000);
+
+    EXPECT_EQ(Decompress(Compress(Text, 4, 10000), 4096), Text);
+    EXPECT_EQ(Decompress(Compress(Text, 3, 1 << 20), 4096), Text);
+    EXPECT_EQ(Decompress(Compress("", 2, 100), 100), "");
+}
+
+TEST(GzipDataSink, CommitWithoutReserveTest){
+    for(std::size_t Threads : {1, 2}){
+        auto Sink = std::make_shared<CStringDataSink>();
+        CGzipDataSink GzipSink(Sink, CGzipDataSink::DefaultLevel, Threads, 100);
+        EXPECT_FALSE(GzipSink.Commit(0));
+        EXPECT_TRUE(GzipSink.WriteBlock("abc", 3));
+        EXPECT_FALSE(GzipSink.Commit(0));
+        ASSERT_NE(GzipSink.Reserve(4), nullptr);
+        EXPECT_TRUE(GzipSink.Put('d'));
+        EXPECT_FALSE(GzipSink.Commit(2));
+        ASSERT_NE(GzipSink.Reserve(4), nullptr);
+        EXPECT_TRUE(GzipSink.Close());
+        EXPECT_EQ(Decompress(Sink->String(), 100), "abcd");
+    }
+}
+
+TEST(GzipDataSource, ConcatenatedTest){
+    std::string First = GenerateText(100);
+    std::string Second = GenerateText(50);
+
+    EXPECT_EQ(Decompress(Compress(First, 1, 100) + Compress(Second, 1, 100), 64), First + Second);
+
+    // Zero padding after a member is accepted, like gzip does
+    std::string Padding(700, '\0');
+    EXPECT_EQ(Decompress(Compress(First, 1, 100) + Padding, 64), First);
+    EXPECT_EQ(Decompress(Compress(First, 1, 100) + Padding + Compress(Second, 1, 100) + Padding, 64), First + Second);
+}
+
+TEST(GzipDataSource, CorruptTest){
+    std::string Compressed = Compress(GenerateText(1000), 1, 4096);
+    std::vector<char> Buffer;
+
+    CGzipDataSource Truncated(std::make_shared<CStringDataSource>(Compressed.substr(0, Compressed.size() / 2)));
+    while(Truncated.Read(Buffer, 1000)){
+    }
+    EXPECT_TRUE(Truncated.End());
+    EXPECT_TRUE(Truncated.HasError());
+
+    CGzipDataSource Garbage(std::make_shared<CStringDataSource>("not compressed"));
+    EXPECT_TRUE(Garbage.End());
+    EXPECT_TRUE(Garbage.HasError());
+}
+
+TEST(GzipDataSource, DSVTest){
+    auto Sink = std::make_shared<CStringDataSink>();
+    auto GzipSink = std::make_shared<CGzipDataSink>(Sink, 1, 2, 512);
+    CDSVWriter Writer(GzipSink, ',');
+    for(int Index = 0; Index < 1000; Index++){
+        EXPECT_TRUE(Writer.WriteRow({std::to_string(Index), "text, with comma"}));
+    }
+    EXPECT_TRUE(GzipSink->Close());
+
+    auto Source = std::make_shared<CGzipDataSource>(std::make_shared<CStringDataSource>(Sink->String()), 256);
+    CDSVReader Reader(Source, ',');
+    std::vector<std::string> Row;
+    int Count = 0;
+    while(Reader.ReadRow(Row)){
+        ASSERT_EQ(Row.size(), 2);
+        EXPECT_EQ(Row[0], std::to_string(Count));
+        EXPECT_EQ(Row[1], "text, with comma");
+        Count++;
+    }
+    EXPECT_EQ(Count, 1000);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "MMapDataSource.h"
+#include <cstdio>
+#include <unistd.h>
+
+static std::string CreateTempFile(const std::string &contents){
+    char Path[] = "/tmp/mmapsourceXXXXXX";
+    int FileDescriptor = mkstemp(Path);
+    if(0 <= FileDescriptor){
+        if(write(FileDescriptor, contents.data(), contents.size()) < 0){
+            Path[0] = '\0';
+        }
+        close(FileDescriptor);
+    }
+    return Path;
+}
+
+TEST(MMapDataSource, MissingFileTest){
+    CMMapDataSource Source("/nonexistent/file.csv");
+    char TempCh = 'x';
+
+    EXPECT_FALSE(Source.IsOpen());
+    EXPECT_TRUE(Source.End());
+    EXPECT_FALSE(Source.Get(TempCh));
+    EXPECT_EQ(TempCh,'x');
+}
+
+TEST(MMapDataSource, EmptyFileTest){
+    std::string Path = CreateTempFile("");
+    CMMapDataSource Source(Path);
+    std::vector<char> TempVector;
+
+    EXPECT_TRUE(Source.IsOpen());
+    EXPECT_TRUE(Source.End());
+    EXPECT_FALSE(Source.Read(TempVector,4));
+    unlink(Path.c_str());
+}
+
+TEST(MMapDataSource, MappedTest){
+    std::string Path = CreateTempFile("Hello World");
+    CMMapDataSource Source(Path);
+    const char *Data = nullptr;
+    std::size_t Length = 0;
+    std::vector<char> TempVector;
+    char TempCh = 'x';
+
+    ASSERT_TRUE(Source.IsMapped());
+    EXPECT_EQ(Source.Size(),11);
+    EXPECT_TRUE(Source.Get(TempCh));
+    EXPECT_EQ(TempCh,'H');
+    EXPECT_TRUE(Source.Borrow(Data,Length));
+    EXPECT_EQ(std::string(Data,Length),"ello World");
+    EXPECT_EQ(Data,Source.Data() + 1);
+    EXPECT_TRUE(Source.Commit(5));
+    EXPECT_TRUE(Source.Peek(TempCh));
+    EXPECT_EQ(TempCh,'W');
+    EXPECT_TRUE(Source.Read(TempVector,10));
+    EXPECT_EQ(std::string(TempVector.begin(),TempVector.end()),"World");
+    EXPECT_TRUE(Source.End());
+    unlink(Path.c_str());
+}
+
+TEST(MMapDataSource, PipeTest){
+    int Pipe[2];
+    ASSERT_EQ(pipe(Pipe),0);
+    std::string Contents = "a,b\nc,d\n";
+    ASSERT_EQ(write(Pipe[1], Contents.data(), Contents.size()),(ssize_t)Contents.size());
+    close(Pipe[1]);
+
+    CMMapDataSource Source(Pipe[0], true, 3);
+    const char *Data = nullptr;
+    std::size_t Length = 0;
+    std::vector<char> TempVector;
+    char TempCh = 'x';
+
+    EXPECT_FALSE(Source.IsMapped());
+    EXPECT_TRUE(Source.Borrow(Data,Length));
+    EXPECT_EQ(std::string(Data,Length),"a,b");
+    EXPECT_TRUE(Source.Commit(4));
+    EXPECT_TRUE(Source.Peek(TempCh));
+    EXPECT_EQ(TempCh,'c');
+    EXPECT_TRUE(Source.Read(TempVector,8));
+    EXPECT_EQ(std::string(TempVector.begin(),TempVector.end()),"c,d\n");
+    EXPECT_TRUE(Source.End());
+}
+
+TEST(MMapDataSource, ZeroSizeFileTest){
+    CMMapDataSource Source("/proc/self/status", 16);
+    std::vector<char> TempVector;
+    std::string Contents;
+
+    ASSERT_TRUE(Source.IsOpen());
+    EXPECT_FALSE(Source.IsMapped());
+    EXPECT_FALSE(Source.End());
+    while(Source.Read(TempVector,100)){
+        Contents.append(TempVector.begin(),TempVector.end());
+    }
+    EXPECT_EQ(Contents.compare(0, 5, "Name:"), 0);
+    EXPECT_TRUE(Source.End());
+}
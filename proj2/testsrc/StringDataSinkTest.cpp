@@ -30,3 +30,36 @@ TEST(StringDataSink, WriteTest){
     EXPECT_TRUE(Sink.Write(TempVector2));
     EXPECT_EQ(Sink.String(),"Hello World");   
 }
+
+TEST(StringDataSink, ReserveCommitTest){
+    CStringDataSink Sink;
+
+    EXPECT_TRUE(Sink.Put('H'));
+    char *Buffer = Sink.Reserve(8);
+    ASSERT_NE(Buffer,nullptr);
+    Buffer[0] = 'e';
+    Buffer[1] = 'l';
+    Buffer[2] = 'l';
+    Buffer[3] = 'o';
+    EXPECT_TRUE(Sink.Commit(4));
+    EXPECT_EQ(Sink.String(),"Hello");
+    EXPECT_TRUE(Sink.Put('!'));
+    EXPECT_EQ(Sink.String(),"Hello!");
+}
+
+TEST(StringDataSink, CommitWithoutReserveTest){
+    CStringDataSink Sink;
+
+    EXPECT_FALSE(Sink.Commit(0));
+    ASSERT_NE(Sink.Reserve(4),nullptr);
+    EXPECT_TRUE(Sink.Commit(0));
+    EXPECT_TRUE(Sink.Write({'a','b','c'}));
+    EXPECT_FALSE(Sink.Commit(0));
+    EXPECT_EQ(Sink.String(),"abc");
+
+    // Writes drop a reservation that was not committed
+    ASSERT_NE(Sink.Reserve(4),nullptr);
+    EXPECT_TRUE(Sink.Put('d'));
+    EXPECT_FALSE(Sink.Commit(2));
+    EXPECT_EQ(Sink.String(),"abcd");
+}
@@ -81,3 +81,24 @@ TEST(StringDataSource, ReadTest){
     EXPECT_FALSE(Source2.Peek(TempCh));
     EXPECT_EQ(TempCh,'x');
 }
+
+TEST(StringDataSource, BorrowCommitTest){
+    CStringDataSource EmptySource("");
+    CStringDataSource Source("Hello");
+    const char *Data = nullptr;
+    std::size_t Length = 1;
+    char TempCh = 'x';
+
+    EXPECT_FALSE(EmptySource.Borrow(Data,Length));
+    EXPECT_EQ(Length,0);
+    EXPECT_TRUE(Source.Borrow(Data,Length));
+    ASSERT_EQ(Length,5);
+    EXPECT_EQ(std::string(Data,Length),"Hello");
+    EXPECT_TRUE(Source.Commit(2));
+    EXPECT_TRUE(Source.Peek(TempCh));
+    EXPECT_EQ(TempCh,'l');
+    EXPECT_TRUE(Source.Borrow(Data,Length));
+    EXPECT_EQ(std::string(Data,Length),"llo");
+    EXPECT_FALSE(Source.Commit(4));
+    EXPECT_TRUE(Source.End());
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "StringReplacer.h"
+#include "StringUtils.h"
+
+TEST(StringReplacer, ReplaceTest){
+    CStringReplacer Replacer({{"cat", "dog"}, {"dog", "cat"}, {"&", " and "}});
+
+    EXPECT_EQ(Replacer.PatternCount(), 3);
+    EXPECT_EQ(Replacer.Replace("cat&dog"), "dog and cat");
+    EXPECT_EQ(Replacer.Replace("catdogcat"), "dogcatdog");
+    EXPECT_EQ(Replacer.Replace("no matches here"), "no matches here");
+    EXPECT_EQ(Replacer.Replace(""), "");
+}
+
+TEST(StringReplacer, OverlapTest){
+    CStringReplacer Replacer({{"he", "1"}, {"she", "2"}, {"hers", "3"}, {"his", "4"}, {"c", "5"}, {"abcd", "6"}});
+
+    // Leftmost match first, then the longest at that position
+    EXPECT_EQ(Replacer.Replace("ushers"), "u2rs");
+    EXPECT_EQ(Replacer.Replace("hershe"), "31");
+    EXPECT_EQ(Replacer.Replace("abcde"), "6e");
+    EXPECT_EQ(Replacer.Replace("abce"), "ab5e");
+    EXPECT_EQ(Replacer.Replace("hishe"), "41");
+    EXPECT_EQ(Replacer.Replace("hisshe"), "42");
+
+    std::string Buffer = "> ";
+    Replacer.Append(Buffer, "this");
+    EXPECT_EQ(Buffer, "> t4");
+}
+
+TEST(StringReplacer, MatchesSequentialTest){
+    // Patterns that cannot overlap give the same result as chained Replace calls
+    std::vector< std::pair< std::string, std::string > > Table;
+    for(int Index = 0; Index < 40; Index++){
+        Table.emplace_back("<" + std::to_string(Index) + ">", "[" + std::to_string(Index * 3) + "]");
+    }
+    CStringReplacer Replacer(Table);
+    std::string Text;
+    for(int Index = 0; Index < 500; Index++){
+        Text += "text <" + std::to_string(Index % 45) + "> ";
+    }
+    std::string Expected = Text;
+    for(auto &Entry : Table){
+        Expected = StringUtils::Replace(Expected, Entry.first, Entry.second);
+    }
+    EXPECT_EQ(Replacer.Replace(Text), Expected);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <climits>
 #include "StringUtils.h"
 
 TEST(StringUtilsTest, Slice) {
@@ -90,7 +91,7 @@ TEST(StringUtilsTest, Join) {
 }
 
 TEST(StringUtilsTest, ExpandTabs) {
-    EXPECT_EQ(StringUtils::ExpandTabs("hello\tworld", 4), "hello    world");
+    EXPECT_EQ(StringUtils::ExpandTabs("hello\tworld", 4), "hello   world");
     EXPECT_EQ(StringUtils::ExpandTabs("\t", 4), "    ");
     EXPECT_EQ(StringUtils::ExpandTabs("hello\t", 8), "hello   ");
     EXPECT_EQ(StringUtils::ExpandTabs("b\t123211", 0), "b123211");
@@ -103,3 +104,159 @@ TEST(StringUtilsTest, EditDistance) {
     EXPECT_EQ(StringUtils::EditDistance("same", "same"), 0);
     EXPECT_EQ(StringUtils::EditDistance("hello", "HELLO", true), 0);
 }
+
+TEST(StringUtilsTest, Views) {
+    std::string text = "  hello world  ";
+    std::string_view stripped = StringUtils::StripView(text);
+    EXPECT_EQ(stripped, "hello world");
+    EXPECT_EQ(stripped.data(), text.data() + 2);
+    EXPECT_EQ(StringUtils::LStripView(text), "hello world  ");
+    EXPECT_EQ(StringUtils::RStripView(text), "  hello world");
+    EXPECT_EQ(StringUtils::SliceView(stripped, -5), "world");
+    EXPECT_EQ(StringUtils::SliceView(stripped, 3, 100), "lo world");
+    EXPECT_EQ(StringUtils::SliceView(stripped, 8, 2), "");
+
+    std::vector<std::string_view> parts;
+    EXPECT_EQ(StringUtils::SplitView("a,,b,", parts, ","), 4);
+    EXPECT_EQ(parts, std::vector<std::string_view>({"a", "", "b", ""}));
+    EXPECT_EQ(StringUtils::SplitView(" \tone  two\n", parts), 2);
+    EXPECT_EQ(parts, std::vector<std::string_view>({"one", "two"}));
+    EXPECT_EQ(StringUtils::SplitView("", parts, ","), 0);
+}
+
+TEST(StringUtilsTest, SplitRange) {
+    std::vector<std::string_view> parts;
+    for (auto part : StringUtils::SplitRange("key::value::", "::")) {
+        parts.push_back(part);
+    }
+    EXPECT_EQ(parts, std::vector<std::string_view>({"key", "value", ""}));
+
+    auto range = StringUtils::SplitRange("   ");
+    EXPECT_TRUE(range.begin() == range.end());
+}
+
+TEST(StringUtilsTest, Buffers) {
+    std::string text = "Hello World 1";
+    StringUtils::UpperInPlace(text);
+    EXPECT_EQ(text, "HELLO WORLD 1");
+    StringUtils::LowerInPlace(text);
+    EXPECT_EQ(text, "hello world 1");
+
+    std::string buffer = "x:";
+    StringUtils::AppendUpper(buffer, "ab");
+    StringUtils::AppendLower(buffer, "CD");
+    StringUtils::AppendReplace(buffer, "a-b-c", "-", "+=");
+    EXPECT_EQ(buffer, "x:ABcda+=b+=c");
+}
+
+static int ReferenceEditDistance(const std::string &left, const std::string &right) {
+    std::vector<std::vector<int>> table(left.length() + 1, std::vector<int>(right.length() + 1));
+    for (size_t i = 0; i <= left.length(); i++) table[i][0] = i;
+    for (size_t j = 0; j <= right.length(); j++) table[0][j] = j;
+    for (size_t i = 1; i <= left.length(); i++) {
+        for (size_t j = 1; j <= right.length(); j++) {
+            table[i][j] = std::min({table[i - 1][j] + 1, table[i][j - 1] + 1, table[i - 1][j - 1] + (left[i - 1] != right[j - 1])});
+        }
+    }
+    return table[left.length()][right.length()];
+}
+
+TEST(StringUtilsTest, BoundedEditDistance) {
+    EXPECT_EQ(StringUtils::BoundedEditDistance("kitten", "sitting", 3), 3);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("kitten", "sitting", 2), 3);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("a", "abcdef", 2), 3);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("", "", 0), 0);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("Hello", "hELLO", 0, true), 0);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("kitten", "sitting", INT_MAX), 3);
+    EXPECT_EQ(StringUtils::BoundedEditDistance("", "abc", INT_MAX), 3);
+    EXPECT_EQ(StringUtils::BoundedEditDistance(std::string(100, 'a'), std::string(70, 'b'), INT_MAX), 100);
+
+    // Lengths on both sides of the 64 character bit-parallel limit
+    unsigned seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    for (int trial = 0; trial < 200; trial++) {
+        std::string left, right;
+        size_t left_length = next() % 150;
+        for (size_t index = 0; index < left_length; index++) {
+            left += 'a' + next() % 4;
+        }
+        right = left;
+        for (int edit = next() % 20; edit > 0; edit--) {
+            size_t position = right.empty() ? 0 : next() % right.size();
+            switch (next() % 3) {
+                case 0: right.insert(position, 1, 'a' + next() % 4); break;
+                case 1: if (!right.empty()) right.erase(position, 1); break;
+                default: if (!right.empty()) right[position] = 'a' + next() % 4; break;
+            }
+        }
+        int expected = ReferenceEditDistance(left, right);
+        EXPECT_EQ(StringUtils::EditDistance(left, right), expected);
+        EXPECT_EQ(StringUtils::BoundedEditDistance(left, right, 8), std::min(expected, 9));
+        EXPECT_EQ(StringUtils::BoundedEditDistance(left, right, INT_MAX), expected);
+    }
+}
+
+TEST(StringUtilsTest, FindMatches) {
+    std::vector<std::string> candidates = {"apple", "apply", "maple", "APPLE", "banana", "applesauce", "ape"};
+    auto matches = StringUtils::FindMatches("apple", candidates, 2);
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_EQ(matches[0].DIndex, 0);
+    EXPECT_EQ(matches[0].DDistance, 0);
+    EXPECT_EQ(matches[1].DIndex, 1);
+    EXPECT_EQ(matches[1].DDistance, 1);
+    EXPECT_EQ(matches[2].DIndex, 2);
+    EXPECT_EQ(matches[3].DIndex, 6);
+
+    auto threaded = StringUtils::FindMatches("apple", candidates, 2, true, 3);
+    ASSERT_EQ(threaded.size(), 5);
+    EXPECT_EQ(threaded[3].DIndex, 3);
+    EXPECT_EQ(threaded[3].DDistance, 0);
+
+    auto unbounded = StringUtils::FindMatches("apple", candidates, INT_MAX);
+    ASSERT_EQ(unbounded.size(), candidates.size());
+    EXPECT_EQ(unbounded[4].DDistance, 5);
+}
+
+TEST(StringUtilsTest, CaseKernels) {
+    // Every byte value at every offset within the vector widths
+    std::string text;
+    for (int repeat = 0; repeat < 3; repeat++) {
+        for (int value = 0; value < 256; value++) {
+            text += static_cast<char>(value);
+        }
+    }
+    for (size_t offset = 0; offset < 40; offset++) {
+        std::string part = text.substr(offset);
+        std::string upper = part;
+        std::string lower = part;
+        for (auto &character : upper) {
+            if ('a' <= character && character <= 'z') character -= 0x20;
+        }
+        for (auto &character : lower) {
+            if ('A' <= character && character <= 'Z') character += 0x20;
+        }
+        EXPECT_EQ(StringUtils::Upper(part), upper);
+        EXPECT_EQ(StringUtils::Lower(part), lower);
+        StringUtils::LowerInPlace(part);
+        EXPECT_EQ(part, lower);
+    }
+}
+
+TEST(StringUtilsTest, StripKernels) {
+    for (size_t padding = 0; padding < 70; padding += 3) {
+        std::string spaces;
+        for (size_t index = 0; index < padding; index++) {
+            spaces += " \t\n\v\f\r"[index % 6];
+        }
+        std::string text = spaces + "x \xA0y" + spaces;
+        EXPECT_EQ(StringUtils::LStripView(text), "x \xA0y" + spaces);
+        EXPECT_EQ(StringUtils::RStripView(text), spaces + "x \xA0y");
+        StringUtils::StripInPlace(text);
+        EXPECT_EQ(text, "x \xA0y");
+        EXPECT_EQ(StringUtils::Strip(spaces), "");
+    }
+    EXPECT_EQ(StringUtils::Strip("\xA0 text \x85"), "\xA0 text \x85");
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "TextEscaper.h"
+#include "StringDataSink.h"
+
+TEST(TextEscaper, FindSpecialTest){
+    CTextEscaper Escaper({{'<', "&lt;"}, {'&', "&amp;"}});
+    std::string Text(100, 'a');
+
+    EXPECT_EQ(Escaper.FindSpecial(Text.data(), Text.size()), 100);
+    Text[70] = '&';
+    EXPECT_EQ(Escaper.FindSpecial(Text.data(), Text.size()), 70);
+    Text[20] = '<';
+    EXPECT_EQ(Escaper.FindSpecial(Text.data(), Text.size()), 20);
+    EXPECT_EQ(Escaper.FindSpecial(Text.data(), 20), 20);
+}
+
+TEST(TextEscaper, EscapeTest){
+    CTextEscaper Escaper({{'<', "&lt;"}, {'&', "&amp;"}, {'"', "\"\""}});
+    std::string Text = std::string(40, 'x') + "a<b & \"c\"" + std::string(40, 'y');
+    std::string Expected = std::string(40, 'x') + "a&lt;b &amp; \"\"c\"\"" + std::string(40, 'y');
+    std::string Output = "prefix:";
+
+    EXPECT_EQ(Escaper.EscapedLength(Text), Expected.size());
+    Escaper.Append(Output, Text);
+    EXPECT_EQ(Output, "prefix:" + Expected);
+    EXPECT_EQ(Escaper.EscapedLength(""), 0);
+}
+
+TEST(TextEscaper, WriteTest){
+    CTextEscaper Escaper({{'&', "&amp;"}});
+    CStringDataSink Sink;
+    std::string Text;
+    for(int Index = 0; Index < 3000; Index++){
+        Text += "a&";
+    }
+    std::string Expected;
+    for(int Index = 0; Index < 3000; Index++){
+        Expected += "a&amp;";
+    }
+
+    EXPECT_TRUE(Escaper.Write(Sink, Text));
+    EXPECT_EQ(Sink.String(), Expected);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "XMLDocument.h"
 #include "XMLReader.h"
 #include "XMLWriter.h"
 #include "StringDataSource.h"
@@ -124,4 +125,505 @@ TEST(XMLReader, SkipCDataTest) {
     EXPECT_EQ(Entity.DNameData, "test");
     
     EXPECT_TRUE(Reader.End());
-}
\ No newline at end of file
+}
+
+TEST(XMLReader, ManyEntitiesTest) {
+    std::string Document = "<root>";
+    for(int Index = 0; Index < 300; Index++) {
+        Document += "<item id=\"" + std::to_string(Index) + "\">text</item>";
+    }
+    Document += "</root>";
+    auto Source = std::make_shared<CStringDataSource>(Document);
+    CXMLReader Reader(Source);
+    
+    SXMLEntity Entity;
+    EXPECT_TRUE(Reader.ReadEntity(Entity, true));
+    EXPECT_EQ(Entity.DNameData, "root");
+    for(int Index = 0; Index < 300; Index++) {
+        ASSERT_TRUE(Reader.ReadEntity(Entity, true));
+        EXPECT_EQ(Entity.DType, SXMLEntity::EType::StartElement);
+        EXPECT_EQ(Entity.AttributeValue("id"), std::to_string(Index));
+        ASSERT_TRUE(Reader.ReadEntity(Entity, true));
+        EXPECT_EQ(Entity.DType, SXMLEntity::EType::EndElement);
+        EXPECT_TRUE(Entity.DAttributes.empty());
+    }
+    EXPECT_TRUE(Reader.ReadEntity(Entity, true));
+    EXPECT_EQ(Entity.DType, SXMLEntity::EType::EndElement);
+    EXPECT_EQ(Entity.DNameData, "root");
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadEntity(Entity));
+}
+
+TEST(XMLReader, ChunkSizeTest) {
+    std::string Document = "<root a=\"1\">";
+    for(int Index = 0; Index < 50; Index++) {
+        Document += "<value>" + std::to_string(Index) + "</value>";
+    }
+    Document += "</root>";
+    
+    for(std::size_t ChunkSize : {1, 7, 64, 100000}) {
+        CXMLReader Reader(std::make_shared<CStringDataSource>(Document), ChunkSize, 256);
+        SXMLEntity Entity;
+        int Count = 0;
+        std::string Text;
+        while(Reader.ReadEntity(Entity)) {
+            if(Entity.DType == SXMLEntity::EType::CharData) {
+                Text += Entity.DNameData;
+            }
+            Count++;
+        }
+        EXPECT_TRUE(Reader.End());
+        EXPECT_GE(Count, 152);
+        EXPECT_EQ(Text.size(), 90);
+    }
+}
+
+TEST(XMLReader, MalformedTest) {
+    auto Source = std::make_shared<CStringDataSource>("<a><b></a>");
+    CXMLReader Reader(Source);
+    
+    SXMLEntity Entity;
+    int Count = 0;
+    while(Reader.ReadEntity(Entity)) {
+        Count++;
+    }
+    EXPECT_EQ(Count, 2);
+    EXPECT_FALSE(Reader.ReadEntity(Entity));
+}
+
+TEST(XMLReader, MalformedEndTest) {
+    std::string Document = "<a><b></a>";
+    for(int Index = 0; Index < 100; Index++) {
+        Document += "<c>text</c>";
+    }
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Document), 4);
+    
+    SXMLEntity Entity;
+    int Count = 0;
+    int Reads = 0;
+    while(!Reader.End() && Reads < 1000) {
+        Count += Reader.ReadEntity(Entity);
+        Reads++;
+    }
+    EXPECT_TRUE(Reader.End());
+    EXPECT_LT(Reads, 1000);
+    EXPECT_EQ(Count, 2);
+}
+
+TEST(XMLReader, EntityViewTest) {
+    auto Source = std::make_shared<CStringDataSource>("<osm><tag k=\"a\" v=\"1\"/><tag k=\"b\" v=\"2\">x &amp; y</tag></osm>");
+    CXMLReader Reader(Source);
+    
+    SXMLEntityView Entity;
+    EXPECT_TRUE(Reader.ReadEntityView(Entity));
+    EXPECT_EQ(Entity.DType, SXMLEntity::EType::StartElement);
+    EXPECT_EQ(Entity.DNameData, "osm");
+    
+    EXPECT_TRUE(Reader.ReadEntityView(Entity));
+    uint32_t TagAtom = Entity.DNameAtom;
+    uint32_t KeyAtom = Reader.NameTable().Find("k");
+    EXPECT_EQ(Entity.DNameData, "tag");
+    ASSERT_EQ(Entity.DAttributeCount, 2);
+    EXPECT_EQ(Entity.DAttributes[0].DNameAtom, KeyAtom);
+    EXPECT_EQ(Entity.AttributeValue("v"), "1");
+    
+    EXPECT_TRUE(Reader.ReadEntityView(Entity));
+    EXPECT_EQ(Entity.DType, SXMLEntity::EType::EndElement);
+    EXPECT_EQ(Entity.DNameAtom, TagAtom);
+    
+    EXPECT_TRUE(Reader.ReadEntityView(Entity));
+    EXPECT_EQ(Entity.DNameAtom, TagAtom);
+    ASSERT_NE(Entity.FindAttribute(KeyAtom), nullptr);
+    EXPECT_EQ(Entity.FindAttribute(KeyAtom)->DValue, "b");
+    
+    std::string Text;
+    while(Reader.ReadEntityView(Entity) && Entity.DType == SXMLEntity::EType::CharData) {
+        EXPECT_EQ(Entity.DNameAtom, CXMLNameTable::InvalidAtom);
+        Text += std::string(Entity.DNameData);
+    }
+    EXPECT_EQ(Text, "x & y");
+    EXPECT_EQ(Entity.DType, SXMLEntity::EType::EndElement);
+    EXPECT_EQ(Reader.NameTable().Size(), 4);
+}
+
+// Forwards to a string sink and fails every write while DFail is set
+class CFailingDataSink : public CDataSink {
+    public:
+        CStringDataSink DSink;
+        bool DFail = false;
+
+        bool Put(const char &ch) noexcept override {
+            return !DFail && DSink.Put(ch);
+        }
+        bool Write(const std::vector<char> &buf) noexcept override {
+            return !DFail && DSink.Write(buf);
+        }
+};
+
+TEST(XMLWriter, SinkFailureTest) {
+    auto Sink = std::make_shared<CFailingDataSink>();
+    CXMLWriter Writer(Sink);
+    
+    SXMLEntity Entity;
+    Entity.DType = SXMLEntity::EType::StartElement;
+    Entity.DNameData = "root";
+    EXPECT_TRUE(Writer.WriteEntity(Entity));
+    
+    // Nesting written to a failing sink is not remembered
+    Sink->DFail = true;
+    Entity.DNameData = "lost";
+    EXPECT_FALSE(Writer.WriteEntity(Entity));
+    Entity.DType = SXMLEntity::EType::EndElement;
+    Entity.DNameData = "root";
+    EXPECT_FALSE(Writer.WriteEntity(Entity));
+    Sink->DFail = false;
+    
+    Entity.DType = SXMLEntity::EType::StartElement;
+    Entity.DNameData = "kept";
+    EXPECT_TRUE(Writer.WriteEntity(Entity));
+    EXPECT_TRUE(Writer.Flush());
+    EXPECT_EQ(Sink->DSink.String(), "<root><kept></kept></root>");
+}
+
+TEST(XMLEntity, AttributeIndexTest) {
+    SXMLEntity Entity;
+    Entity.DType = SXMLEntity::EType::StartElement;
+    for(int Index = 0; Index < 20; Index++) {
+        EXPECT_TRUE(Entity.SetAttribute("key" + std::to_string(Index), std::to_string(Index * 2)));
+    }
+    EXPECT_TRUE(std::is_aggregate_v<SXMLEntity>);
+    SXMLEntity::SAttributeKey Key("key7");
+    SXMLEntity::SAttributeIndex Index;
+    EXPECT_EQ(Index.Find(Entity, Key), nullptr);
+    Index.Build(Entity);
+    
+    ASSERT_NE(Index.Find(Entity, Key), nullptr);
+    EXPECT_EQ(Index.Find(Entity, Key)->second, "14");
+    EXPECT_EQ(Index.Find(Entity, SXMLEntity::SAttributeKey("key19")), &Entity.DAttributes[19]);
+    EXPECT_EQ(Index.Find(Entity, SXMLEntity::SAttributeKey("key20")), nullptr);
+    EXPECT_EQ(Entity.AttributeView("key19"), "38");
+    EXPECT_FALSE(Entity.AttributeExists("key20"));
+    EXPECT_TRUE(Entity.SetAttribute("key7", "seven"));
+    EXPECT_EQ(Entity.AttributeValue("key7"), "seven");
+    EXPECT_EQ(Entity.DAttributes.size(), 20);
+    
+    Entity.DAttributes.push_back(std::make_pair("added", "yes"));
+    EXPECT_EQ(Entity.AttributeView("added"), "yes");
+    
+    // Renamed in place, the index sees the change once it is built again
+    Entity.DAttributes[0].first = "renamed";
+    Index.Build(Entity);
+    EXPECT_EQ(Index.Find(Entity, SXMLEntity::SAttributeKey("renamed")), &Entity.DAttributes[0]);
+    EXPECT_EQ(Index.Find(Entity, SXMLEntity::SAttributeKey("key0")), nullptr);
+    EXPECT_EQ(Index.Find(Entity, SXMLEntity::SAttributeKey("added")), &Entity.DAttributes[20]);
+    
+    SXMLEntity Copy = Entity;
+    EXPECT_EQ(Copy.AttributeView("key3"), "6");
+    EXPECT_EQ(Copy.FindAttribute("key3"), &Copy.DAttributes[3]);
+}
+
+TEST(XMLEntity, AttributeIndexReuseTest) {
+    std::string Input = "<root>";
+    for(char Prefix : {'x', 'y'}) {
+        Input += "<e";
+        for(int Index = 0; Index < 10; Index++) {
+            Input += " " + std::string(1, Prefix) + std::to_string(Index) + "=\"" + Prefix + std::to_string(Index) + "\"";
+        }
+        Input += "/>";
+    }
+    Input += "</root>";
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+    SXMLEntity Entity;
+    
+    EXPECT_TRUE(Reader.ReadEntity(Entity));
+    EXPECT_TRUE(Reader.ReadEntity(Entity));
+    EXPECT_EQ(Entity.AttributeView("x3"), "x3");
+    EXPECT_TRUE(Reader.ReadEntity(Entity));
+    EXPECT_TRUE(Reader.ReadEntity(Entity));
+    EXPECT_EQ(Entity.DAttributes.size(), 10);
+    EXPECT_EQ(Entity.AttributeView("y3"), "y3");
+    EXPECT_FALSE(Entity.AttributeExists("x3"));
+}
+
+TEST(XMLWriter, WriteEntitiesTest) {
+    auto Sink = std::make_shared<CStringDataSink>();
+    CXMLWriter Writer(Sink);
+    
+    std::vector<SXMLEntity> Entities(5);
+    Entities[0].DType = SXMLEntity::EType::StartElement;
+    Entities[0].DNameData = "root";
+    Entities[0].SetAttribute("a", "x<y");
+    Entities[1].DType = SXMLEntity::EType::CompleteElement;
+    Entities[1].DNameData = "empty";
+    Entities[2].DType = SXMLEntity::EType::CharData;
+    Entities[2].DNameData = "\"quoted\" & 'single'";
+    Entities[3].DType = SXMLEntity::EType::EndElement;
+    Entities[3].DNameData = "root";
+    Entities[4].DType = SXMLEntity::EType::EndElement;
+    Entities[4].DNameData = "root";
+    
+    EXPECT_FALSE(Writer.WriteEntities(Entities));
+    EXPECT_EQ(Sink->String(), "<root a=\"x&lt;y\"><empty/>&quot;quoted&quot; &amp; &apos;single&apos;</root>");
+    Entities.pop_back();
+    Entities.erase(Entities.begin() + 1, Entities.end());
+    EXPECT_TRUE(Writer.WriteEntities(Entities));
+    EXPECT_TRUE(Writer.Flush());
+    EXPECT_EQ(Sink->String(), "<root a=\"x&lt;y\"><empty/>&quot;quoted&quot; &amp; &apos;single&apos;</root><root a=\"x&lt;y\"></root>");
+}
+
+TEST(XMLReader, StatsTest){
+    std::string Input = "<root><item id=\"1\">text</item><item id=\"2\"/></root>";
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input), 8);
+    SXMLEntity Entity;
+    int Count = 0;
+
+    while(Reader.ReadEntity(Entity)){
+        Count++;
+    }
+    auto Stats = Reader.Stats();
+    if(SIOStats::Enabled){
+        EXPECT_EQ(Stats.DRecords, Count);
+        EXPECT_EQ(Stats.DBytes, Input.size());
+        EXPECT_GT(Stats.DChunks, 1);
+        EXPECT_GT(Stats.DQueueHighWater, 0);
+        EXPECT_LE(Stats.DQueueHighWater, Count);
+    }
+    else{
+        EXPECT_EQ(Stats.DRecords, 0);
+        EXPECT_EQ(Stats.DChunks, 0);
+    }
+
+    auto Sink = std::make_shared<CStringDataSink>();
+    CXMLWriter Writer(Sink);
+    Entity.DType = SXMLEntity::EType::StartElement;
+    Entity.DNameData = "a_long_element_name";
+    Entity.DAttributes.clear();
+    EXPECT_TRUE(Writer.WriteEntity(Entity));
+    EXPECT_TRUE(Writer.Flush());
+    auto WriterStats = Writer.Stats();
+    if(SIOStats::Enabled){
+        EXPECT_EQ(WriterStats.DRecords, 1);
+        EXPECT_EQ(WriterStats.DBytes, Sink->String().size());
+        EXPECT_EQ(WriterStats.DAllocations, 1);
+    }
+    else{
+        EXPECT_EQ(WriterStats.DBytes, 0);
+    }
+}
+
+class CRecordingHandler : public CXMLHandler{
+    public:
+        std::string DEvents;
+        std::size_t DStopAfter = SIZE_MAX;
+
+        bool Record(const std::string &event){
+            DEvents += event + ";";
+            return --DStopAfter;
+        }
+        bool StartElement(const SXMLEntityView &entity) override{
+            std::string Event = "<" + std::string(entity.DNameData);
+            for(std::size_t Index = 0; Index < entity.DAttributeCount; Index++){
+                Event += " " + std::string(entity.DAttributes[Index].DName) + "=" + std::string(entity.DAttributes[Index].DValue);
+            }
+            return Record(Event);
+        }
+        bool EndElement(const SXMLEntityView &entity) override{
+            return Record("/" + std::string(entity.DNameData));
+        }
+        bool CharData(std::string_view text) override{
+            return Record(std::string(text));
+        }
+};
+
+TEST(XMLReader, HandlerTest){
+    std::string Input = "<root><a x=\"1\" y=\"&amp;\">text</a><b/></root>";
+    CRecordingHandler Handler;
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+
+    EXPECT_TRUE(Reader.Parse(Handler));
+    EXPECT_EQ(Handler.DEvents, "<root;<a x=1 y=&;text;/a;<b;/b;/root;");
+    EXPECT_TRUE(Reader.End());
+
+    CRecordingHandler Skipping;
+    CXMLReader SkippingReader(std::make_shared<CStringDataSource>(Input));
+    SXMLEntity Entity;
+    EXPECT_TRUE(SkippingReader.ReadEntity(Entity));
+    EXPECT_TRUE(SkippingReader.Parse(Skipping, true));
+    EXPECT_EQ(Skipping.DEvents, "<a x=1 y=&;/a;<b;/b;/root;");
+}
+
+TEST(XMLReader, HandlerStopTest){
+    CRecordingHandler Handler;
+    Handler.DStopAfter = 2;
+    CXMLReader Reader(std::make_shared<CStringDataSource>("<root><a/><b/></root>"));
+    SXMLEntity Entity;
+
+    EXPECT_FALSE(Reader.Parse(Handler));
+    EXPECT_EQ(Handler.DEvents, "<root;<a;");
+    EXPECT_TRUE(Reader.End());
+    EXPECT_FALSE(Reader.ReadEntity(Entity));
+
+    // Stopping with most of the document still in the source
+    CRecordingHandler Early;
+    Early.DStopAfter = 1;
+    CXMLReader EarlyReader(std::make_shared<CStringDataSource>("<root><a/><b/><c/><d/></root>"), 4);
+    EXPECT_FALSE(EarlyReader.Parse(Early));
+    EXPECT_EQ(Early.DEvents, "<root;");
+    EXPECT_TRUE(EarlyReader.End());
+    EXPECT_FALSE(EarlyReader.ReadEntity(Entity));
+    EXPECT_TRUE(EarlyReader.End());
+
+    // Stopping on an entity that was already queued by ReadEntity
+    std::string Document = "<root>";
+    for(int Index = 0; Index < 100; Index++) {
+        Document += "<a/>";
+    }
+    Document += "</root>";
+    CRecordingHandler Queued;
+    Queued.DStopAfter = 1;
+    CXMLReader QueuedReader(std::make_shared<CStringDataSource>(Document), 64);
+    EXPECT_TRUE(QueuedReader.ReadEntity(Entity));
+    EXPECT_FALSE(QueuedReader.Parse(Queued));
+    EXPECT_EQ(Queued.DEvents, "<a;");
+    EXPECT_TRUE(QueuedReader.End());
+    EXPECT_FALSE(QueuedReader.ReadEntity(Entity));
+
+    CRecordingHandler Malformed;
+    CXMLReader MalformedReader(std::make_shared<CStringDataSource>("<root><a></b></root>"));
+    EXPECT_FALSE(MalformedReader.Parse(Malformed));
+}
+
+static std::string ReadFiltered(const std::string &input, const std::string &path){
+    CXMLPathFilter Filter;
+    EXPECT_TRUE(Filter.AddPath(path));
+    CXMLReader Reader(std::make_shared<CStringDataSource>(input), 16);
+    Reader.SetFilter(Filter);
+    SXMLEntity Entity;
+    std::string Result;
+    while(Reader.ReadEntity(Entity)){
+        Result += Entity.DType == SXMLEntity::EType::EndElement ? "/" : "";
+        Result += Entity.DNameData + ";";
+    }
+    return Result;
+}
+
+TEST(XMLReader, PathFilterTest){
+    std::string Input = "<osm><node id=\"1\"><tag k=\"a\"/></node>"
+                        "<way id=\"2\" type=\"road\"><nd ref=\"1\"/><tag k=\"b\">x</tag></way>"
+                        "<way id=\"3\"><tag k=\"c\"/><sub><tag k=\"d\"/></sub></way></osm>";
+
+    EXPECT_EQ(ReadFiltered(Input, "/osm/way/tag"), "tag;x;/tag;tag;/tag;");
+    EXPECT_EQ(ReadFiltered(Input, "//tag[@k='d']"), "tag;/tag;");
+    EXPECT_EQ(ReadFiltered(Input, "/osm/way[@type=\"road\"]/nd"), "nd;/nd;");
+    EXPECT_EQ(ReadFiltered(Input, "/osm/*[@id='1']"), "node;tag;/tag;/node;");
+    EXPECT_EQ(ReadFiltered(Input, "/osm/way[@type]//tag|/osm/node/tag"), "tag;/tag;tag;x;/tag;");
+    EXPECT_EQ(ReadFiltered(Input, "//sub//tag"), "tag;/tag;");
+    EXPECT_EQ(ReadFiltered(Input, "/way"), "");
+    EXPECT_EQ(ReadFiltered("<r><t k=\"a|b\"/><t k=\"a]\"/><t k=\"c\"/></r>", "//t[@k='a|b']|//t[@k=\"a]\"]"), "t;/t;t;/t;");
+
+    CXMLPathFilter Filter;
+    EXPECT_FALSE(Filter.AddPath("osm/way"));
+    EXPECT_FALSE(Filter.AddPath("/osm/"));
+    EXPECT_FALSE(Filter.AddPath("/osm/way[id='1']"));
+    EXPECT_FALSE(Filter.AddPath("/osm|/way[@id=1]"));
+    EXPECT_FALSE(Filter.AddPath("//t[@k='a|b]"));
+    EXPECT_TRUE(Filter.Empty());
+
+    // The handler API sees the same filtered entities
+    EXPECT_TRUE(Filter.AddPath("//nd"));
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+    Reader.SetFilter(Filter);
+    CRecordingHandler Handler;
+    EXPECT_TRUE(Reader.Parse(Handler));
+    EXPECT_EQ(Handler.DEvents, "<nd ref=1;/nd;");
+}
+
+TEST(XMLDocument, NavigationTest){
+    std::string Input = "<osm version=\"0.6\"><node id=\"1\" lat=\"2.5\">a<tag k=\"x\"/>b&amp;c</node>"
+                        "<way id=\"2\"><nd ref=\"1\"/><nd ref=\"3\"/></way><node id=\"4\"/></osm>";
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+    CXMLDocument Document;
+
+    EXPECT_TRUE(Document.Load(Reader));
+    EXPECT_EQ(Document.NodeCount(), 9);
+    uint32_t Root = Document.Root();
+    EXPECT_EQ(Document.Name(Root), "osm");
+    EXPECT_EQ(Document.Parent(Root), CXMLDocument::InvalidNode);
+    EXPECT_EQ(Document.AttributeValue(Root, "version"), "0.6");
+
+    uint32_t Node = Document.FirstChild(Root);
+    EXPECT_EQ(Document.Name(Node), "node");
+    EXPECT_EQ(Document.AttributeCount(Node), 2);
+    EXPECT_EQ(Document.AttributeNameAt(Node, 1), "lat");
+    EXPECT_EQ(Document.AttributeValueAt(Node, 1), "2.5");
+    EXPECT_TRUE(Document.AttributeExists(Node, "id"));
+    EXPECT_FALSE(Document.AttributeExists(Node, "ref"));
+    EXPECT_EQ(Document.AttributeValue(Node, "missing"), "");
+
+    uint32_t Text = Document.FirstChild(Node);
+    EXPECT_FALSE(Document.IsElement(Text));
+    EXPECT_EQ(Document.Text(Text), "a");
+    uint32_t Tag = Document.NextSibling(Text);
+    EXPECT_EQ(Document.Name(Tag), "tag");
+    EXPECT_EQ(Document.FirstChild(Tag), CXMLDocument::InvalidNode);
+    // Character data split by the entity reference is merged
+    EXPECT_EQ(Document.Text(Document.NextSibling(Tag)), "b&c");
+    EXPECT_EQ(Document.TextContent(Node), "ab&c");
+    EXPECT_EQ(Document.SubtreeEnd(Node), Document.NextSibling(Node));
+
+    uint32_t NodeAtom = Document.Atom("node");
+    uint32_t Way = Document.FirstChild(Root, Document.Atom("way"));
+    EXPECT_EQ(Document.Parent(Way), Root);
+    EXPECT_EQ(Document.AttributeValue(Document.FirstChild(Way), Document.Atom("ref")), "1");
+    EXPECT_EQ(Document.AttributeValue(Document.NextSibling(Document.FirstChild(Way)), "ref"), "3");
+    uint32_t Last = Document.NextSibling(Node, NodeAtom);
+    EXPECT_EQ(Document.AttributeValue(Last, "id"), "4");
+    EXPECT_EQ(Document.NextSibling(Last, NodeAtom), CXMLDocument::InvalidNode);
+    EXPECT_EQ(Document.SubtreeEnd(Root), Document.NodeCount());
+    EXPECT_EQ(Document.FirstChild(Root, Document.Atom("relation")), CXMLDocument::InvalidNode);
+}
+
+TEST(XMLDocument, LoadTest){
+    CXMLDocument Document;
+    CXMLReader Skipping(std::make_shared<CStringDataSource>("<a>x<b>y</b>z</a>"));
+    EXPECT_TRUE(Document.Load(Skipping, true));
+    EXPECT_EQ(Document.NodeCount(), 2);
+    EXPECT_EQ(Document.TextContent(Document.Root()), "");
+
+    // Loading after some reads keeps the rest of the document, the element
+    // left open before the load ends without a node
+    CXMLReader Partial(std::make_shared<CStringDataSource>("<a><b/><c>t</c><d/></a>"));
+    SXMLEntity Entity;
+    EXPECT_TRUE(Partial.ReadEntity(Entity));
+    EXPECT_TRUE(Document.Load(Partial));
+    EXPECT_EQ(Document.NodeCount(), 4);
+    EXPECT_EQ(Document.Name(Document.Root()), "b");
+    uint32_t C = Document.NextSibling(Document.Root());
+    EXPECT_EQ(Document.Text(Document.FirstChild(C)), "t");
+    EXPECT_EQ(Document.Name(Document.NextSibling(C)), "d");
+    EXPECT_EQ(Document.Atom("a"), CXMLNameTable::InvalidAtom);
+
+    CXMLReader Malformed(std::make_shared<CStringDataSource>("<a><b></a>"));
+    EXPECT_FALSE(Document.Load(Malformed));
+}
+
+TEST(XMLDocument, WhitespaceTest){
+    std::string Input = "<root>\n  <p>line one\nline two\n\nend &amp;\n more</p>\n  <q> <b>x</b> </q>\n</root>\n";
+    CXMLReader Reader(std::make_shared<CStringDataSource>(Input));
+    CXMLDocument Document;
+
+    EXPECT_TRUE(Document.Load(Reader));
+    uint32_t P = Document.FirstChild(Document.Root());
+    EXPECT_EQ(Document.Name(P), "p");
+    EXPECT_EQ(Document.TextContent(P), "line one\nline two\n\nend &\n more");
+    EXPECT_EQ(Document.NextSibling(Document.FirstChild(P)), CXMLDocument::InvalidNode);
+
+    // Whitespace between elements does not become text nodes
+    uint32_t Q = Document.NextSibling(P);
+    EXPECT_EQ(Document.Name(Q), "q");
+    EXPECT_EQ(Document.NextSibling(Q), CXMLDocument::InvalidNode);
+    uint32_t B = Document.FirstChild(Q);
+    EXPECT_EQ(Document.Name(B), "b");
+    EXPECT_EQ(Document.NextSibling(B), CXMLDocument::InvalidNode);
+    EXPECT_EQ(Document.NodeCount(), 6);
+}